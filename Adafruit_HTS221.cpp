@@ -36,21 +36,51 @@
 
 #include "Arduino.h"
 #include <Wire.h>
+#include <new>
 
 #include "Adafruit_HTS221.h"
 
+// assembles a little endian 16-bit register pair from a burst read buffer
+static inline uint16_t _le16(const uint8_t *buffer) {
+  return (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+}
+
+// the configuration set up by begin
+static void _defaultConfig(hts221_config_t *config) {
+  config->active = true; // arise!
+  // set to max data rate (default is one shot)
+  config->data_rate = HTS221_RATE_12_5_HZ;
+  // block data update; output LSB and MSB are from the same sample
+  config->block_data_update = true;
+  config->heater = false;
+  config->drdy_active_low = false;
+  config->drdy_open_drain = false;
+  config->drdy_int_enabled = false;
+  config->averaging = HTS221_AV_CONF_DEFAULT;
+}
+
+// limits a requested SPI clock to what the sensor supports
+static uint32_t _spiFrequency(uint32_t frequency) {
+  return frequency > HTS221_SPI_MAX_FREQ ? HTS221_SPI_MAX_FREQ : frequency;
+}
+
+#if HTS221_ENABLE_STATS
+// adds the time since start_us to a running total and maximum
+static void _addTime(uint32_t *total_us, uint32_t *max_us, uint32_t start_us) {
+  uint32_t elapsed_us = (uint32_t)micros() - start_us;
+  *total_us += elapsed_us;
+  if (elapsed_us > *max_us) {
+    *max_us = elapsed_us;
+  }
+}
+#endif
+
 /*!
  *    @brief  Instantiates a new HTS221 class
  */
-Adafruit_HTS221::Adafruit_HTS221(void) {}
-Adafruit_HTS221::~Adafruit_HTS221(void) {
-  if (temp_sensor) {
-    delete temp_sensor;
-  }
-  if (humidity_sensor) {
-    delete humidity_sensor;
-  }
-}
+Adafruit_HTS221::Adafruit_HTS221(void)
+    : _temp_sensor(this), _humidity_sensor(this) {}
+Adafruit_HTS221::~Adafruit_HTS221(void) { _releaseBus(); }
 
 /*!
  *    @brief  Sets up the hardware and initializes I2C
@@ -64,119 +94,580 @@ Adafruit_HTS221::~Adafruit_HTS221(void) {
  */
 bool Adafruit_HTS221::begin_I2C(uint8_t i2c_address, TwoWire *wire,
                                 int32_t sensor_id) {
+  return begin_I2C(NULL, i2c_address, wire, sensor_id);
+}
 
-  if (i2c_dev) {
-    delete i2c_dev; // remove old interface
-  }
-
-  i2c_dev = new Adafruit_I2CDevice(i2c_address, wire);
+/*!
+ *    @brief  Sets up the hardware and initializes I2C, restoring calibration
+ *            saved with `getCalibration()` instead of rebooting the sensor
+ *            and reading it back
+ *    @param  calibration
+ *            Calibration from a previous `getCalibration()`. If NULL or it
+ *            doesn't match the chip, the sensor is booted and its
+ *            calibration is read as usual
+ *    @param  i2c_address
+ *            The I2C address to be used.
+ *    @param  wire
+ *            The Wire object to be used for I2C connections.
+ *    @param  sensor_id
+ *            The unique ID to differentiate the sensors from others
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_HTS221::begin_I2C(const hts221_calibration_t *calibration,
+                                uint8_t i2c_address, TwoWire *wire,
+                                int32_t sensor_id) {
+  _releaseBus(); // remove old interface
+  i2c_dev = new (_bus_storage) Adafruit_I2CDevice(i2c_address, wire);
 
   if (!i2c_dev->begin()) {
     return false;
   }
 
-  return _init(sensor_id);
+  return _init(sensor_id, calibration);
 }
 
 /*!
- *    @brief  Sets up the hardware and initializes hardware SPI
+ *    @brief  Sets up the hardware and initializes hardware SPI.
+ *
+ *            The HTS221's SPI port is 3-wire, with one bidirectional SDI/SDO
+ *            data pin. Connect MISO straight to SDI/SDO and MOSI to it
+ *            through a resistor (a few kOhm), so the sensor can overdrive
+ *            MOSI when it answers a read.
  *    @param  cs_pin The arduino pin # connected to chip select
  *    @param  theSPI The SPI object to be used for SPI connections.
  *    @param  sensor_id
  *            The user-defined ID to differentiate different sensors
+ *    @param  frequency
+ *            The SPI clock in Hz, up to HTS221_SPI_MAX_FREQ
  *    @return True if initialization was successful, otherwise false.
  */
 bool Adafruit_HTS221::begin_SPI(uint8_t cs_pin, SPIClass *theSPI,
-                                int32_t sensor_id) {
-  i2c_dev = NULL;
+                                int32_t sensor_id, uint32_t frequency) {
+  return begin_SPI(NULL, cs_pin, theSPI, sensor_id, frequency);
+}
 
-  if (spi_dev) {
-    delete spi_dev; // remove old interface
-  }
-  spi_dev = new Adafruit_SPIDevice(cs_pin,
-                                   1000000,               // frequency
-                                   SPI_BITORDER_MSBFIRST, // bit order
-                                   SPI_MODE0,             // data mode
-                                   theSPI);
+/*!
+ *    @brief  Sets up the hardware and initializes hardware SPI, restoring
+ *            calibration saved with `getCalibration()` instead of rebooting
+ *            the sensor and reading it back
+ *    @param  calibration
+ *            Calibration from a previous `getCalibration()`. If NULL or it
+ *            doesn't match the chip, the sensor is booted and its
+ *            calibration is read as usual
+ *    @param  cs_pin The arduino pin # connected to chip select
+ *    @param  theSPI The SPI object to be used for SPI connections.
+ *    @param  sensor_id
+ *            The user-defined ID to differentiate different sensors
+ *    @param  frequency
+ *            The SPI clock in Hz, up to HTS221_SPI_MAX_FREQ
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_HTS221::begin_SPI(const hts221_calibration_t *calibration,
+                                uint8_t cs_pin, SPIClass *theSPI,
+                                int32_t sensor_id, uint32_t frequency) {
+  _releaseBus(); // remove old interface
+  spi_dev = new (_bus_storage)
+      Adafruit_SPIDevice(cs_pin,
+                         _spiFrequency(frequency), // frequency
+                         SPI_BITORDER_MSBFIRST,    // bit order
+                         SPI_MODE0,                // data mode
+                         theSPI);
   if (!spi_dev->begin()) {
     return false;
   }
 
-  return _init(sensor_id);
+  return _init(sensor_id, calibration);
 }
 
 /*!
- *    @brief  Sets up the hardware and initializes software SPI
+ *    @brief  Sets up the hardware and initializes software SPI. The data
+ *            pins are wired as for hardware SPI; see `begin_SPI()`
  *    @param  cs_pin The arduino pin # connected to chip select
  *    @param  sck_pin The arduino pin # connected to SPI clock
  *    @param  miso_pin The arduino pin # connected to SPI MISO
  *    @param  mosi_pin The arduino pin # connected to SPI MOSI
  *    @param  sensor_id
  *            The user-defined ID to differentiate different sensors
+ *    @param  frequency
+ *            The SPI clock in Hz, up to HTS221_SPI_MAX_FREQ
  *    @return True if initialization was successful, otherwise false.
  */
 bool Adafruit_HTS221::begin_SPI(int8_t cs_pin, int8_t sck_pin, int8_t miso_pin,
-                                int8_t mosi_pin, int32_t sensor_id) {
-  i2c_dev = NULL;
+                                int8_t mosi_pin, int32_t sensor_id,
+                                uint32_t frequency) {
+  _releaseBus(); // remove old interface
+  spi_dev = new (_bus_storage)
+      Adafruit_SPIDevice(cs_pin, sck_pin, miso_pin, mosi_pin,
+                         _spiFrequency(frequency), // frequency
+                         SPI_BITORDER_MSBFIRST,    // bit order
+                         SPI_MODE0);               // data mode
+  if (!spi_dev->begin()) {
+    return false;
+  }
 
-  if (spi_dev) {
-    delete spi_dev; // remove old interface
+  return _init(sensor_id);
+}
+
+/*!
+ *    @brief  Sets up the sensor on an I2C device owned by the caller. The
+ *            driver never frees or rebuilds it, so a device in static
+ *            storage can be passed to every re-init
+ *    @param  i2c_device The I2C device for the sensor
+ *    @param  calibration
+ *            Optional calibration from a previous `getCalibration()`
+ *    @param  sensor_id
+ *            The unique ID to differentiate the sensors from others
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_HTS221::begin_I2C(Adafruit_I2CDevice *i2c_device,
+                                const hts221_calibration_t *calibration,
+                                int32_t sensor_id) {
+  _releaseBus(); // remove old interface
+  i2c_dev = i2c_device;
+
+  if (!i2c_dev->begin()) {
+    return false;
   }
-  spi_dev = new Adafruit_SPIDevice(cs_pin, sck_pin, miso_pin, mosi_pin,
-                                   1000000,               // frequency
-                                   SPI_BITORDER_MSBFIRST, // bit order
-                                   SPI_MODE0);            // data mode
+
+  return _init(sensor_id, calibration);
+}
+
+/*!
+ *    @brief  Sets up the sensor on an SPI device owned by the caller. The
+ *            driver never frees or rebuilds it, so a device in static
+ *            storage can be passed to every re-init
+ *    @param  spi_device The SPI device for the sensor
+ *    @param  calibration
+ *            Optional calibration from a previous `getCalibration()`
+ *    @param  sensor_id
+ *            The user-defined ID to differentiate different sensors
+ *    @return True if initialization was successful, otherwise false.
+ */
+bool Adafruit_HTS221::begin_SPI(Adafruit_SPIDevice *spi_device,
+                                const hts221_calibration_t *calibration,
+                                int32_t sensor_id) {
+  _releaseBus(); // remove old interface
+  spi_dev = spi_device;
+
   if (!spi_dev->begin()) {
     return false;
   }
 
-  return _init(sensor_id);
+  return _init(sensor_id, calibration);
 }
 
 /*!  @brief Initializer for post i2c/spi init
  *   @param sensor_id Optional unique ID for the sensor set
+ *   @param calibration Optional saved calibration to use instead of booting
+ *   the sensor and reading it
  *   @returns True if chip identified and initialized
  */
-bool Adafruit_HTS221::_init(int32_t sensor_id) {
-  if (spi_dev) {
-    multi_byte_address_mask = 0x40;
-  }
-  Adafruit_BusIO_Register chip_id = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_WHOAMI, 1);
+bool Adafruit_HTS221::_init(int32_t sensor_id,
+                            const hts221_calibration_t *calibration) {
+  _begin_step = BEGIN_STEP_IDLE;
+  _have_sample = false;
+  _calibrated = false;
+  _oneshot_waiting = 0;
+  multi_byte_address_mask = spi_dev ? 0x40 : 0x80;
 
   // make sure we're talking to the right chip
-  if (chip_id.read() != HTS221_CHIP_ID) {
+  uint8_t chip_id;
+  if (!_readRegisters(HTS221_WHOAMI, &chip_id, 1) ||
+      chip_id != HTS221_CHIP_ID) {
     return false;
   }
 
   _sensorid_humidity = sensor_id;
   _sensorid_temp = sensor_id + 1;
-  boot();
-  setActive(true); // arise!
-  setDataRate(
-      HTS221_RATE_12_5_HZ); // set to max data rate (default is one shot)
 
-  _fetchTempCalibrationValues();
-  _fetchHumidityCalibrationValues();
+  // saved calibration means the trimming was already restored on a previous
+  // power up, so the boot wait and calibration reads can be skipped. T0_OUT
+  // is read back so a blob saved from another part isn't used for this one
+  bool warm_start = false;
+  if (calibration) {
+    uint8_t t0_out[2];
+    if (!_readRegisters(HTS221_T0_OUT, t0_out, 2)) {
+      return false;
+    }
+    warm_start = _le16(t0_out) == calibration->t0_out &&
+                 _loadCalibration(calibration);
+  }
+  if (!warm_start && !_boot()) {
+    return false;
+  }
+
+  hts221_config_t config;
+  _defaultConfig(&config);
+  // forces every register to be written so the shadow copies match the chip
+  _av_conf = ~HTS221_AV_CONF_DEFAULT;
+  if (!configure(&config)) {
+    return false;
+  }
+
+  if (!warm_start) {
+    if (!_fetchCalibrationValues()) {
+      return false;
+    }
+  }
 
-  humidity_sensor = new Adafruit_HTS221_Humidity(this);
-  temp_sensor = new Adafruit_HTS221_Temp(this);
+  _createSensors();
   return true;
 }
 
+/*!  @brief Hands out the Unified Sensor objects once init has finished.
+ *   They live inside this object, so re-running begin doesn't allocate
+ */
+void Adafruit_HTS221::_createSensors(void) {
+  humidity_sensor = &_humidity_sensor;
+  temp_sensor = &_temp_sensor;
+}
+
+/*!
+ *    @brief  Destroys the bus device built by a previous begin, if any.
+ *            Devices passed in by the caller are left alone
+ */
+void Adafruit_HTS221::_releaseBus(void) {
+  if ((void *)i2c_dev == _bus_storage) {
+    i2c_dev->~Adafruit_I2CDevice();
+  }
+  if ((void *)spi_dev == _bus_storage) {
+    spi_dev->~Adafruit_SPIDevice();
+  }
+  i2c_dev = NULL;
+  spi_dev = NULL;
+  // the calibration belonged to the part on the old bus
+  _calibrated = false;
+}
+
+/*!
+ *    @brief  Starts initializing the sensor over I2C without blocking. Call
+ *            `pollBegin()` until it returns `HTS221_BEGIN_READY` or
+ *            `HTS221_BEGIN_ERROR`
+ *    @param  i2c_address
+ *            The I2C address to be used.
+ *    @param  wire
+ *            The Wire object to be used for I2C connections.
+ *    @param  sensor_id
+ *            The unique ID to differentiate the sensors from others
+ */
+void Adafruit_HTS221::startBegin_I2C(uint8_t i2c_address, TwoWire *wire,
+                                     int32_t sensor_id) {
+  _releaseBus(); // remove old interface
+  i2c_dev = new (_bus_storage) Adafruit_I2CDevice(i2c_address, wire);
+  multi_byte_address_mask = 0x80;
+  _startBegin(sensor_id);
+}
+
+/*!
+ *    @brief  Starts initializing the sensor over hardware SPI without
+ *            blocking. Call `pollBegin()` until it returns
+ *            `HTS221_BEGIN_READY` or `HTS221_BEGIN_ERROR`
+ *    @param  cs_pin The arduino pin # connected to chip select
+ *    @param  theSPI The SPI object to be used for SPI connections.
+ *    @param  sensor_id
+ *            The user-defined ID to differentiate different sensors
+ *    @param  frequency
+ *            The SPI clock in Hz, up to HTS221_SPI_MAX_FREQ
+ */
+void Adafruit_HTS221::startBegin_SPI(uint8_t cs_pin, SPIClass *theSPI,
+                                     int32_t sensor_id, uint32_t frequency) {
+  _releaseBus(); // remove old interface
+  spi_dev = new (_bus_storage)
+      Adafruit_SPIDevice(cs_pin,
+                         _spiFrequency(frequency), // frequency
+                         SPI_BITORDER_MSBFIRST,    // bit order
+                         SPI_MODE0,                // data mode
+                         theSPI);
+  multi_byte_address_mask = 0x40;
+  _startBegin(sensor_id);
+}
+
+/*!  @brief Resets the non-blocking init to its first step
+ *   @param sensor_id Optional unique ID for the sensor set
+ */
+void Adafruit_HTS221::_startBegin(int32_t sensor_id) {
+  _sensorid_humidity = sensor_id;
+  _sensorid_temp = sensor_id + 1;
+  _begin_step = BEGIN_STEP_DEVICE;
+  _have_sample = false;
+  _oneshot_waiting = 0;
+  _begin_start_us = micros();
+  _begin_elapsed_us = 0;
+}
+
+/*!
+ *    @brief  Advances a `startBegin_I2C()` or `startBegin_SPI()` init by one
+ *            step. Each call does at most one bus transaction and never
+ *            delays, so it can be called from a cooperative main loop
+ *    @param  elapsed_us
+ *            Optional; set to the microseconds since init was started, or
+ *            the total init time once it has finished
+ *    @return The state of the init
+ */
+hts221_begin_status_t Adafruit_HTS221::pollBegin(uint32_t *elapsed_us) {
+  hts221_begin_status_t status = HTS221_BEGIN_BUSY;
+  hts221_config_t config;
+
+  switch (_begin_step) {
+  case BEGIN_STEP_IDLE:
+    status = HTS221_BEGIN_IDLE;
+    break;
+
+  case BEGIN_STEP_DEVICE:
+    if (i2c_dev ? i2c_dev->begin() : spi_dev->begin()) {
+      _begin_step = BEGIN_STEP_WHOAMI;
+    } else {
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+    break;
+
+  case BEGIN_STEP_WHOAMI: {
+    // make sure we're talking to the right chip
+    uint8_t chip_id;
+    if (_readRegisters(HTS221_WHOAMI, &chip_id, 1) &&
+        chip_id == HTS221_CHIP_ID) {
+      _begin_step = BEGIN_STEP_BOOT;
+    } else {
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+  } break;
+
+  case BEGIN_STEP_BOOT:
+    _ctrl_2 = 0;
+    if (_writeRegister(HTS221_CTRL_REG_2, HTS221_CTRL_2_BOOT)) {
+      _boot_start_ms = millis();
+      _begin_step = BEGIN_STEP_BOOT_WAIT;
+    } else {
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+    break;
+
+  case BEGIN_STEP_BOOT_WAIT: {
+    uint8_t value;
+    if (!_readRegisters(HTS221_CTRL_REG_2, &value, 1)) {
+      _begin_step = BEGIN_STEP_ERROR;
+    } else if (!(value & HTS221_CTRL_2_BOOT)) {
+      _begin_step = BEGIN_STEP_AV_CONF;
+    } else if (millis() - _boot_start_ms >= HTS221_BOOT_TIMEOUT_MS) {
+      // a stuck BOOT bit, or a bus reading back 0xFF, would never clear
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+  } break;
+
+  case BEGIN_STEP_AV_CONF:
+    if (_writeRegister(HTS221_AV_CONF, HTS221_AV_CONF_DEFAULT)) {
+      _av_conf = HTS221_AV_CONF_DEFAULT;
+      _begin_step = BEGIN_STEP_CONFIG;
+    } else {
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+    break;
+
+  case BEGIN_STEP_CONFIG:
+    // AV_CONF is already written, so this is just the CTRL_REG burst
+    _defaultConfig(&config);
+    if (configure(&config)) {
+      _begin_step = BEGIN_STEP_CALIBRATION;
+    } else {
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+    break;
+
+  case BEGIN_STEP_CALIBRATION:
+    if (_fetchCalibrationValues()) {
+      _createSensors();
+      _begin_step = BEGIN_STEP_READY;
+    } else {
+      _begin_step = BEGIN_STEP_ERROR;
+    }
+    break;
+
+  case BEGIN_STEP_READY:
+    status = HTS221_BEGIN_READY;
+    break;
+
+  default:
+    status = HTS221_BEGIN_ERROR;
+    break;
+  }
+
+  if (status == HTS221_BEGIN_BUSY) {
+    _begin_elapsed_us = micros() - _begin_start_us;
+    if (_begin_step == BEGIN_STEP_READY) {
+      status = HTS221_BEGIN_READY;
+    } else if (_begin_step == BEGIN_STEP_ERROR) {
+      status = HTS221_BEGIN_ERROR;
+    }
+  }
+  if (elapsed_us) {
+    *elapsed_us = (status == HTS221_BEGIN_IDLE) ? 0 : _begin_elapsed_us;
+  }
+  return status;
+}
+
 /**
  * @brief Restores the trimming function values into registers from flash
  *
  */
-void Adafruit_HTS221::boot(void) {
-  Adafruit_BusIO_Register ctrl_2 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_CTRL_REG_2, 1);
-  Adafruit_BusIO_RegisterBits boot = Adafruit_BusIO_RegisterBits(&ctrl_2, 1, 7);
+void Adafruit_HTS221::boot(void) { _boot(); }
 
-  boot.write(1);
-  while (boot.read()) {
+/**
+ * @brief Reboots the sensor's memory and waits for BOOT to clear
+ *
+ * @return true if BOOT cleared within HTS221_BOOT_TIMEOUT_MS
+ */
+bool Adafruit_HTS221::_boot(void) {
+  if (!_writeRegister(HTS221_CTRL_REG_2, _ctrl_2 | HTS221_CTRL_2_BOOT)) {
+    return false;
+  }
+  // BOOT clears itself once the trimming values have been reloaded
+  uint32_t start_ms = millis();
+  uint8_t ctrl_2;
+  while (_readRegisters(HTS221_CTRL_REG_2, &ctrl_2, 1)) {
+    if (!(ctrl_2 & HTS221_CTRL_2_BOOT)) {
+      return true;
+    }
+    // a stuck BOOT bit, or a bus reading back 0xFF, would never clear
+    if (millis() - start_ms >= HTS221_BOOT_TIMEOUT_MS) {
+      return false;
+    }
     delay(1);
   }
+  return false;
+}
+
+/**
+ * @brief Writes a single register, for updating from the shadow copies
+ *
+ * @param reg The register address
+ * @param value The value to write
+ * @return true if the write succeeded
+ */
+bool Adafruit_HTS221::_writeRegister(uint8_t reg, uint8_t value) {
+  return _writeRegisters(reg, &value, 1);
+}
+
+/**
+ * @brief Reads one or more consecutive registers in a single bus transaction.
+ * Every register read the driver makes goes through here, so this is the one
+ * place to hook when tracing or counting bus traffic
+ *
+ * @param reg The first register address
+ * @param buffer Where to put the register values
+ * @param len The number of registers to read
+ * @return true if the read succeeded
+ */
+bool Adafruit_HTS221::_readRegisters(uint8_t reg, uint8_t *buffer,
+                                     uint8_t len) {
+  if (len > 1) {
+    reg |= multi_byte_address_mask;
+  }
+  Adafruit_BusIO_Register regs =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, reg, 1);
+#if HTS221_ENABLE_STATS
+  uint32_t start_us = micros();
+  bool ok = regs.read(buffer, len);
+  if (_stats) {
+    _stats->transactions++;
+    _stats->bytes += len + 1;
+    _addTime(&_stats->bus_us, &_stats->bus_max_us, start_us);
+  }
+  return ok;
+#else
+  return regs.read(buffer, len);
+#endif
+}
+
+/**
+ * @brief Writes one or more consecutive registers in a single bus
+ * transaction. Like `_readRegisters`, every register write ends up here
+ *
+ * @param reg The first register address
+ * @param buffer The register values to write
+ * @param len The number of registers to write
+ * @return true if the write succeeded
+ */
+bool Adafruit_HTS221::_writeRegisters(uint8_t reg, uint8_t *buffer,
+                                      uint8_t len) {
+  if (len > 1) {
+    reg |= multi_byte_address_mask;
+  }
+  Adafruit_BusIO_Register regs =
+      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, reg, 1);
+#if HTS221_ENABLE_STATS
+  uint32_t start_us = micros();
+  bool ok = regs.write(buffer, len);
+  if (_stats) {
+    _stats->transactions++;
+    _stats->bytes += len + 1;
+    _addTime(&_stats->bus_us, &_stats->bus_max_us, start_us);
+  }
+  return ok;
+#else
+  return regs.write(buffer, len);
+#endif
+}
+
+/**
+ * @brief Applies a complete configuration. CTRL_REG1-3 are written with one
+ * auto-incrementing burst; AV_CONF is only written if it changed.
+ *
+ * @param config The configuration to apply
+ * @return true if the configuration was written successfully
+ */
+bool Adafruit_HTS221::configure(const hts221_config_t *config) {
+  uint8_t ctrl[3];
+  ctrl[0] = (uint8_t)(config->data_rate & HTS221_CTRL_1_ODR);
+  if (config->active) {
+    ctrl[0] |= HTS221_CTRL_1_PD;
+  }
+  if (config->block_data_update) {
+    ctrl[0] |= HTS221_CTRL_1_BDU;
+  }
+  ctrl[1] = config->heater ? HTS221_CTRL_2_HEATER : 0;
+  ctrl[2] = 0;
+  if (config->drdy_active_low) {
+    ctrl[2] |= HTS221_CTRL_3_DRDY_H_L;
+  }
+  if (config->drdy_open_drain) {
+    ctrl[2] |= HTS221_CTRL_3_PP_OD;
+  }
+  if (config->drdy_int_enabled) {
+    ctrl[2] |= HTS221_CTRL_3_DRDY_EN;
+  }
+
+  if (config->averaging != _av_conf) {
+    if (!_writeRegister(HTS221_AV_CONF, config->averaging)) {
+      return false;
+    }
+    _av_conf = config->averaging;
+  }
+
+  if (!_writeRegisters(HTS221_CTRL_REG_1, ctrl, 3)) {
+    return false;
+  }
+  _ctrl_1 = ctrl[0];
+  _ctrl_2 = ctrl[1];
+  _ctrl_3 = ctrl[2];
+  _outputs_stale |= (_ctrl_1 & HTS221_CTRL_1_ODR) != 0;
+  return true;
+}
+
+/**
+ * @brief Gets the current configuration from the driver's copy of the
+ * control registers, without any bus traffic
+ *
+ * @param config The configuration struct to fill in
+ */
+void Adafruit_HTS221::getConfig(hts221_config_t *config) {
+  config->active = _ctrl_1 & HTS221_CTRL_1_PD;
+  config->data_rate = (hts221_rate_t)(_ctrl_1 & HTS221_CTRL_1_ODR);
+  config->block_data_update = _ctrl_1 & HTS221_CTRL_1_BDU;
+  config->heater = _ctrl_2 & HTS221_CTRL_2_HEATER;
+  config->drdy_active_low = _ctrl_3 & HTS221_CTRL_3_DRDY_H_L;
+  config->drdy_open_drain = _ctrl_3 & HTS221_CTRL_3_PP_OD;
+  config->drdy_int_enabled = _ctrl_3 & HTS221_CTRL_3_DRDY_EN;
+  config->averaging = _av_conf;
 }
 
 /**
@@ -185,12 +676,12 @@ void Adafruit_HTS221::boot(void) {
  * @param active Set to true to enable the sensor, false to disable
  */
 void Adafruit_HTS221::setActive(bool active) {
-  Adafruit_BusIO_Register ctrl_1 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_CTRL_REG_1, 1);
-  Adafruit_BusIO_RegisterBits pd_bit =
-      Adafruit_BusIO_RegisterBits(&ctrl_1, 1, 7);
-
-  pd_bit.write(active);
+  _ctrl_1 &= ~HTS221_CTRL_1_PD;
+  if (active) {
+    _ctrl_1 |= HTS221_CTRL_1_PD;
+  }
+  _writeRegister(HTS221_CTRL_REG_1, _ctrl_1);
+  _outputs_stale |= (_ctrl_1 & HTS221_CTRL_1_ODR) != 0;
 }
 
 /**
@@ -200,12 +691,11 @@ void Adafruit_HTS221::setActive(bool active) {
  * active low
  */
 void Adafruit_HTS221::drdyActiveLow(bool active_low) {
-  Adafruit_BusIO_Register ctrl_3 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_CTRL_REG_3, 1);
-  Adafruit_BusIO_RegisterBits drdy_active_low_bit =
-      Adafruit_BusIO_RegisterBits(&ctrl_3, 1, 7);
-
-  drdy_active_low_bit.write(active_low);
+  _ctrl_3 &= ~HTS221_CTRL_3_DRDY_H_L;
+  if (active_low) {
+    _ctrl_3 |= HTS221_CTRL_3_DRDY_H_L;
+  }
+  _writeRegister(HTS221_CTRL_REG_3, _ctrl_3);
 }
 
 /**
@@ -215,12 +705,145 @@ void Adafruit_HTS221::drdyActiveLow(bool active_low) {
  * disable
  */
 void Adafruit_HTS221::drdyIntEnabled(bool drdy_int_enabled) {
-  Adafruit_BusIO_Register ctrl_3 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_CTRL_REG_3, 1);
-  Adafruit_BusIO_RegisterBits drdy_int_enabled_bit =
-      Adafruit_BusIO_RegisterBits(&ctrl_3, 1, 2);
+  _ctrl_3 &= ~HTS221_CTRL_3_DRDY_EN;
+  if (drdy_int_enabled) {
+    _ctrl_3 |= HTS221_CTRL_3_DRDY_EN;
+  }
+  _writeRegister(HTS221_CTRL_REG_3, _ctrl_3);
+}
+
+/**
+ * @brief Sets how many internal temperature samples are averaged for each
+ * output. More averaging lowers noise but costs supply current.
+ *
+ * @param averaging The number of samples. Must be a `hts221_temp_avg_t`
+ */
+void Adafruit_HTS221::setTemperatureAveraging(hts221_temp_avg_t averaging) {
+  _av_conf &= ~HTS221_AV_CONF_AVGT;
+  _av_conf |= (averaging << 3) & HTS221_AV_CONF_AVGT;
+  _writeRegister(HTS221_AV_CONF, _av_conf);
+}
+
+/**
+ * @brief Returns the current temperature averaging
+ *
+ * @return hts221_temp_avg_t the number of samples averaged
+ */
+hts221_temp_avg_t Adafruit_HTS221::getTemperatureAveraging(void) {
+  return (hts221_temp_avg_t)((_av_conf & HTS221_AV_CONF_AVGT) >> 3);
+}
+
+/**
+ * @brief Sets how many internal humidity samples are averaged for each
+ * output. More averaging lowers noise but costs supply current.
+ *
+ * @param averaging The number of samples. Must be a `hts221_humidity_avg_t`
+ */
+void Adafruit_HTS221::setHumidityAveraging(hts221_humidity_avg_t averaging) {
+  _av_conf &= ~HTS221_AV_CONF_AVGH;
+  _av_conf |= averaging & HTS221_AV_CONF_AVGH;
+  _writeRegister(HTS221_AV_CONF, _av_conf);
+}
 
-  drdy_int_enabled_bit.write(drdy_int_enabled);
+/**
+ * @brief Returns the current humidity averaging
+ *
+ * @return hts221_humidity_avg_t the number of samples averaged
+ */
+hts221_humidity_avg_t Adafruit_HTS221::getHumidityAveraging(void) {
+  return (hts221_humidity_avg_t)(_av_conf & HTS221_AV_CONF_AVGH);
+}
+
+// From table 16 of https://www.st.com/resource/en/datasheet/hts221.pdf,
+// indexed by the AVGT/AVGH setting
+static const uint16_t _temp_noise_mdegc[8] PROGMEM = {80, 50, 40, 30,
+                                                      20, 15, 10, 7};
+static const uint16_t _humidity_noise_centi[8] PROGMEM = {40, 30, 20, 15,
+                                                          10, 7,  5,  3};
+// supply current at 1 Hz, hundredths of a uA
+static const uint16_t _current_1hz_centi_ua[8] PROGMEM = {
+    80, 105, 140, 210, 343, 615, 1160, 2250};
+
+/**
+ * @brief Picks the least averaging that meets the noise targets, and the
+ * slowest data rate that meets the latency target, using the datasheet's
+ * noise and supply current tables
+ *
+ * @param max_temp_noise Highest acceptable temperature noise in degrees C
+ * RMS, or 0 for the least averaging
+ * @param max_humidity_noise Highest acceptable humidity noise in %RH RMS, or
+ * 0 for the least averaging
+ * @param max_latency_ms Longest acceptable time between samples, or 0 to
+ * use one shot mode and trigger conversions with `startOneShot()`
+ * @param profile Filled with the chosen settings and their expected noise
+ * and supply current
+ * @return true if every target can be met; otherwise `profile` holds the
+ * closest settings
+ */
+bool Adafruit_HTS221::planProfile(float max_temp_noise,
+                                  float max_humidity_noise,
+                                  uint32_t max_latency_ms,
+                                  hts221_profile_t *profile) {
+  bool met = true;
+
+  uint8_t t_avg = 0;
+  if (max_temp_noise > 0) {
+    while (t_avg < 7 &&
+           pgm_read_word(&_temp_noise_mdegc[t_avg]) > max_temp_noise * 1000) {
+      t_avg++;
+    }
+    met &= pgm_read_word(&_temp_noise_mdegc[t_avg]) <= max_temp_noise * 1000;
+  }
+  uint8_t h_avg = 0;
+  if (max_humidity_noise > 0) {
+    while (h_avg < 7 && pgm_read_word(&_humidity_noise_centi[h_avg]) >
+                            max_humidity_noise * 100) {
+      h_avg++;
+    }
+    met &= pgm_read_word(&_humidity_noise_centi[h_avg]) <=
+           max_humidity_noise * 100;
+  }
+
+  float rate_hz = 1;
+  if (max_latency_ms == 0) {
+    profile->data_rate = HTS221_RATE_ONE_SHOT;
+  } else if (max_latency_ms >= 1000) {
+    profile->data_rate = HTS221_RATE_1_HZ;
+  } else if (max_latency_ms >= 143) {
+    profile->data_rate = HTS221_RATE_7_HZ;
+    rate_hz = 7;
+  } else {
+    profile->data_rate = HTS221_RATE_12_5_HZ;
+    rate_hz = 12.5;
+    met &= max_latency_ms >= 80;
+  }
+
+  profile->temp_averaging = (hts221_temp_avg_t)t_avg;
+  profile->humidity_averaging = (hts221_humidity_avg_t)h_avg;
+  profile->temp_noise = pgm_read_word(&_temp_noise_mdegc[t_avg]) / 1000.0;
+  profile->humidity_noise =
+      pgm_read_word(&_humidity_noise_centi[h_avg]) / 100.0;
+  // the table is for matching settings, so split the difference when the
+  // two channels use different rows
+  profile->current_ua = (pgm_read_word(&_current_1hz_centi_ua[t_avg]) +
+                         pgm_read_word(&_current_1hz_centi_ua[h_avg])) /
+                        200.0 * rate_hz;
+  return met;
+}
+
+/**
+ * @brief Applies the averaging and data rate from `planProfile()`
+ *
+ * @param profile The profile to apply
+ * @return true if the settings were written successfully
+ */
+bool Adafruit_HTS221::applyProfile(const hts221_profile_t *profile) {
+  hts221_config_t config;
+  getConfig(&config);
+  config.data_rate = profile->data_rate;
+  config.averaging = ((profile->temp_averaging << 3) & HTS221_AV_CONF_AVGT) |
+                     (profile->humidity_averaging & HTS221_AV_CONF_AVGH);
+  return configure(&config);
 }
 
 /**
@@ -229,12 +852,7 @@ void Adafruit_HTS221::drdyIntEnabled(bool drdy_int_enabled) {
  * @return hts221_rate_t the current measurement rate
  */
 hts221_rate_t Adafruit_HTS221::getDataRate(void) {
-  Adafruit_BusIO_Register ctrl_1 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_CTRL_REG_1, 1);
-  Adafruit_BusIO_RegisterBits data_rate_bits =
-      Adafruit_BusIO_RegisterBits(&ctrl_1, 2, 0);
-
-  return (hts221_rate_t)data_rate_bits.read();
+  return (hts221_rate_t)(_ctrl_1 & HTS221_CTRL_1_ODR);
 }
 
 /**
@@ -243,12 +861,10 @@ hts221_rate_t Adafruit_HTS221::getDataRate(void) {
  * @param data_rate The new measurement rate. Must be a `hts221_rate_t`
  */
 void Adafruit_HTS221::setDataRate(hts221_rate_t data_rate) {
-  Adafruit_BusIO_Register ctrl_1 = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD, HTS221_CTRL_REG_1, 1);
-  Adafruit_BusIO_RegisterBits data_rate_bits =
-      Adafruit_BusIO_RegisterBits(&ctrl_1, 2, 0);
-
-  data_rate_bits.write(data_rate);
+  _ctrl_1 &= ~HTS221_CTRL_1_ODR;
+  _ctrl_1 |= (data_rate & HTS221_CTRL_1_ODR);
+  _writeRegister(HTS221_CTRL_REG_1, _ctrl_1);
+  _outputs_stale |= (_ctrl_1 & HTS221_CTRL_1_ODR) != 0;
 }
 
 /**************************************************************************/
@@ -262,12 +878,13 @@ void Adafruit_HTS221::setDataRate(hts221_rate_t data_rate) {
 /**************************************************************************/
 bool Adafruit_HTS221::getEvent(sensors_event_t *humidity,
                                sensors_event_t *temp) {
-  uint32_t t = millis();
   if (_read() != true) {
     return false;
   };
 
-  // use helpers to fill in the events
+  // use helpers to fill in the events, stamped with when the sample was
+  // converted rather than when it was read
+  uint32_t t = _sampleMillis();
   fillTempEvent(temp, t);
   fillHumidityEvent(humidity, t);
   return true;
@@ -291,123 +908,643 @@ void Adafruit_HTS221::fillHumidityEvent(sensors_event_t *humidity,
   humidity->timestamp = timestamp;
   humidity->relative_humidity = corrected_humidity;
 }
+
+/*!
+ *  @brief  Converts the current sample's timestamp to the millis() clock the
+ *          Unified Sensor events use
+ *
+    @returns millis() at the time the sample was converted
+ */
+uint32_t Adafruit_HTS221::_sampleMillis(void) {
+  return millis() - getSampleAge() / 1000;
+}
+
+/*!
+ *  @brief  Works out the age of a reading being handed out, and counts it
+ *          in the latency histogram if statistics are being collected
+ *
+ *  @param  timestamp_us The micros() timestamp of the sample
+ *  @return The age of the sample in microseconds
+ */
+uint32_t Adafruit_HTS221::_recordAge(uint32_t timestamp_us) {
+  uint32_t age_us = (uint32_t)micros() - timestamp_us;
+#if HTS221_ENABLE_STATS
+  if (_stats) {
+    uint8_t bin = 0;
+    while (bin < HTS221_LATENCY_BINS - 1 && age_us >= (256UL << bin)) {
+      bin++;
+    }
+    _stats->latency[bin]++;
+  }
+#endif
+  return age_us;
+}
 /******************* Adafruit_Sensor functions *****************/
 /*!
  *  @brief  Updates the measurement data for all sensors simultaneously
  *
-    @returns true if the event data was read successfully
+    @returns true if the event data was read successfully; false until the
+    sensor has produced its first sample
  */
 /**************************************************************************/
 bool Adafruit_HTS221::_read(void) {
+#if HTS221_ENABLE_STATS
+  uint32_t start_us = micros();
+#endif
+  // until the first sample arrives there is nothing valid to hand out
+  bool ok = _fetchSample() && _have_sample;
+  if (ok) {
+    _convertNew();
+    _recordAge(_converted_us);
+  }
+#if HTS221_ENABLE_STATS
+  if (_stats) {
+    _stats->reads++;
+    if (!ok) {
+      _stats->failed_reads++;
+    }
+    _addTime(&_stats->read_us, &_stats->read_max_us, start_us);
+  }
+#endif
+  return ok;
+}
+
+/*!
+ *  @brief  Converts the raw values that are new since the last conversion;
+ *          the last reading is kept otherwise
+ */
+void Adafruit_HTS221::_convertNew(void) {
+  if (_unconverted & HTS221_STATUS_H_DA) {
+    _applyHumidityCorrection();
+  }
+  if (_unconverted & HTS221_STATUS_T_DA) {
+    _applyTemperatureCorrection();
+  }
+  _unconverted = 0;
+}
+
+/*!
+ *  @brief  Makes sure the raw values are the latest sample, only reading
+ *          the sensor if a new sample could be ready. Within one output
+ *          period of the last new sample the raw values are reused, so
+ *          reading humidity and temperature separately costs one bus read
+ *
+    @returns true if the raw values are current
+ */
+bool Adafruit_HTS221::_fetchSample(void) {
+  hts221_rate_t data_rate = getDataRate();
+  uint32_t period_us = _ratePeriodUs(data_rate);
+  bool fresh;
+  if (data_rate == HTS221_RATE_ONE_SHOT) {
+    // nothing changes until the next one shot is started
+    fresh = !_oneshot_waiting;
+  } else {
+    fresh = ((uint32_t)micros() - _sample_us) < period_us;
+  }
+  if (_have_sample && fresh) {
+    _cache_hits++;
+    return true;
+  }
+  _cache_misses++;
+  return _readRaw();
+}
+
+/*!
+ *  @brief  Gets the time between samples for a data rate
+ *  @param  data_rate The data rate
+ *  @returns The output period in microseconds, or 0 for one shot
+ */
+uint32_t Adafruit_HTS221::_ratePeriodUs(hts221_rate_t data_rate) {
+  switch (data_rate) {
+  case HTS221_RATE_1_HZ:
+    return 1000000;
+  case HTS221_RATE_7_HZ:
+    return 142857;
+  case HTS221_RATE_12_5_HZ:
+    return 80000;
+  default:
+    return 0;
+  }
+}
 
-  Adafruit_BusIO_Register temp_data =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_TEMP_OUT_L | multi_byte_address_mask), 2);
-  Adafruit_BusIO_Register humidity_data = Adafruit_BusIO_Register(
-      i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-      (HTS221_HUMIDITY_OUT | multi_byte_address_mask), 2);
+/**
+ * @brief Starts a single conversion and returns immediately. The data rate
+ * is switched to `HTS221_RATE_ONE_SHOT` and the sensor made active first if
+ * needed. The first one shot after continuous mode also reads in the last
+ * continuous sample, so its data ready bits can't be taken for the result.
+ * Call `pollOneShot()` to find out when the result is ready.
+ *
+ * @return true if the conversion was started
+ */
+bool Adafruit_HTS221::startOneShot(void) {
+  uint8_t ctrl_1 = (_ctrl_1 & ~HTS221_CTRL_1_ODR) | HTS221_CTRL_1_PD;
+  if (ctrl_1 != _ctrl_1) {
+    if (!_writeRegister(HTS221_CTRL_REG_1, ctrl_1)) {
+      return false;
+    }
+    _ctrl_1 = ctrl_1;
+  }
+  // data ready bits left by continuous mode, or by a one shot that was
+  // never collected, would end the wait at once; reading the outputs
+  // clears them, and takes in that sample like any other read
+  if (_outputs_stale || _oneshot_waiting) {
+    if (!_readRaw()) {
+      return false;
+    }
+    _outputs_stale = false;
+  }
+  // ONE_SHOT clears itself when the conversion is done, so it isn't kept in
+  // the shadow copy
+  if (!_writeRegister(HTS221_CTRL_REG_2, _ctrl_2 | HTS221_CTRL_2_ONE_SHOT)) {
+    return false;
+  }
+  _oneshot_waiting = HTS221_STATUS_H_DA | HTS221_STATUS_T_DA;
+  return true;
+}
 
-  raw_humidity = 0;
-  humidity_data.read(&raw_humidity);
+/**
+ * @brief Checks whether the conversion started by `startOneShot()` has
+ * finished. Each call is one status+data burst read, so once it returns
+ * true the result is already loaded and `getEvent()` or `readCenti()` can
+ * be used without any further bus traffic.
+ *
+ * @return true if the result of the last one shot is ready
+ */
+bool Adafruit_HTS221::pollOneShot(void) {
+  if (_oneshot_waiting && !_readRaw()) {
+    return false;
+  }
+  return _have_sample && !_oneshot_waiting;
+}
 
-  uint8_t buffer[2];
-  if (!temp_data.read(buffer, 2)) {
+/**
+ * @brief Starts a split-phase read of the next reading and returns without
+ * waiting for it. Call `pollSample()` until it is ready; the callback, if
+ * any, is called from there with the result.
+ *
+ * The bus libraries have no non-blocking transfers, so the read is broken
+ * into calls that each make at most one short bus transaction instead. In
+ * one shot mode this call starts the conversion. Otherwise it makes no bus
+ * traffic, and the first poll reads the sensor only if a new sample could
+ * be ready.
+ *
+ * @param callback Optional function to call when the reading is ready
+ * @return true if the read was started
+ */
+bool Adafruit_HTS221::requestSample(hts221_reading_callback_t callback) {
+  _request_callback = callback;
+  _request_us = micros();
+  if (getDataRate() == HTS221_RATE_ONE_SHOT && !startOneShot()) {
+    _request_status = HTS221_SAMPLE_ERROR;
     return false;
   }
-  raw_temperature = 0;
+  _request_status = HTS221_SAMPLE_BUSY;
+  return true;
+}
+
+/**
+ * @brief Advances a read started with `requestSample()`. Each call makes at
+ * most one bus transaction and never waits.
+ *
+ * @param reading Optional; set to the converted reading once it is ready
+ * @return hts221_sample_status_t The progress of the read
+ */
+hts221_sample_status_t Adafruit_HTS221::pollSample(hts221_reading_t *reading) {
+  if (_request_status == HTS221_SAMPLE_BUSY) {
+    // in one shot mode wait for the requested conversion; otherwise the
+    // latest sample is the result, reusing it if no newer one can be ready
+    bool ok;
+    if (getDataRate() == HTS221_RATE_ONE_SHOT) {
+      ok = !_oneshot_waiting || _readRaw();
+    } else {
+      ok = _fetchSample();
+    }
+    if (!ok) {
+      _request_status = HTS221_SAMPLE_ERROR;
+    } else if (_have_sample && !_oneshot_waiting) {
+      _reading.timestamp_us = _converted_us;
+      _reading.temperature =
+          hts221_centiTemperature(&_coeffs, (int16_t)raw_temperature);
+      _reading.humidity =
+          hts221_centiHumidity(&_coeffs, (int16_t)raw_humidity);
+      _request_status = HTS221_SAMPLE_READY;
+      if (_request_callback) {
+        _reading.age_us = (uint32_t)micros() - _reading.timestamp_us;
+        _request_callback(&_reading);
+      }
+    } else if ((uint32_t)micros() - _request_us >=
+               HTS221_SAMPLE_TIMEOUT_MS * 1000UL) {
+      _request_status = HTS221_SAMPLE_ERROR;
+    }
+  }
+  if (reading && _request_status == HTS221_SAMPLE_READY) {
+    *reading = _reading;
+    reading->age_us = (uint32_t)micros() - _reading.timestamp_us;
+  }
+  return _request_status;
+}
 
-  raw_temperature = buffer[1];
-  raw_temperature <<= 8;
-  raw_temperature |= buffer[0];
+/**
+ * @brief Starts DRDY driven acquisition. The DRDY pin is enabled, and from
+ * then on `dataReady()` should be called from the pin's interrupt and
+ * `service()` from the main loop to move each new sample into the buffer.
+ * Other calls that read a new sample, such as `getEvent()` or
+ * `readCenti()`, queue it as well, so they can be mixed with `service()`.
+ *
+ * @param buffer The queue that captured samples are pushed into
+ */
+void Adafruit_HTS221::startCapture(Adafruit_HTS221_SampleBuffer *buffer) {
+  _capture = buffer;
+  _dropped_samples = 0;
+  drdyIntEnabled(true);
+  // DRDY may already be high with no edge coming until the data is read, so
+  // read once straight away to re-arm it
+  noInterrupts();
+  _drdy_us = micros();
+  _drdy_pending = true;
+  interrupts();
+}
+
+/**
+ * @brief Stops DRDY driven acquisition and disables the DRDY pin
+ *
+ */
+void Adafruit_HTS221::stopCapture(void) {
+  drdyIntEnabled(false);
+  _capture = NULL;
+  _drdy_pending = false;
+}
+
+/**
+ * @brief Marks a new sample as ready. Safe to call from the DRDY pin's
+ * interrupt handler; it only records the time and does no bus traffic.
+ *
+ */
+void Adafruit_HTS221::dataReady(void) {
+  _drdy_us = micros();
+  _drdy_pending = true;
+}
 
-  if (raw_temperature & 0x8000) {
-    raw_temperature = raw_temperature - 0xFFFF;
+/**
+ * @brief Reads the sample flagged by `dataReady()`, if any, and pushes it
+ * into the capture buffer. Call regularly from the main loop.
+ *
+ * @return true if a new sample was captured
+ */
+bool Adafruit_HTS221::service(void) {
+  if (!_capture || !_drdy_pending) {
+    return false;
   }
 
-  _applyTemperatureCorrection();
-  _applyHumidityCorrection();
+  // _readRaw() picks up the pending edge as the sample's timestamp and
+  // queues the sample
+  uint32_t dropped = _dropped_samples;
+  return _readRaw() &&
+         (_status & (HTS221_STATUS_H_DA | HTS221_STATUS_T_DA)) &&
+         _dropped_samples == dropped;
+}
+
+/**
+ * @brief Gets the number of captured samples lost because the capture
+ * buffer was full
+ *
+ * @return uint32_t The number of dropped samples since `startCapture()`
+ */
+uint32_t Adafruit_HTS221::getDroppedSamples(void) { return _dropped_samples; }
+
+/**
+ * @brief Appends any new samples to an array of compact raw records without
+ * converting them. With DRDY capture running the queued samples are
+ * drained; otherwise the sensor is read once and a record is added if it
+ * had a new sample. Never waits for a sample.
+ *
+ * @param records The array to fill
+ * @param max_records The most records to add
+ * @param deltas_ms Optional array to fill with the milliseconds between
+ * each record and the sample before it
+ * @param ages_us Optional array to fill with how old each record's sample
+ * was when it was handed over, in microseconds
+ * @return uint16_t The number of records added
+ */
+uint16_t Adafruit_HTS221::readBatch(hts221_raw_record_t *records,
+                                    uint16_t max_records, uint16_t *deltas_ms,
+                                    uint32_t *ages_us) {
+  uint16_t count = 0;
+  hts221_raw_sample_t sample;
+
+  while (count < max_records) {
+    if (_capture) {
+      if (!_capture->pop(&sample, 1)) {
+        break;
+      }
+    } else {
+      if (count || !_readRaw() ||
+          !(_status & (HTS221_STATUS_H_DA | HTS221_STATUS_T_DA))) {
+        break;
+      }
+      sample.timestamp_us = _converted_us;
+      sample.temperature = (int16_t)raw_temperature;
+      sample.humidity = (int16_t)raw_humidity;
+    }
+
+    records[count].temperature = sample.temperature;
+    records[count].humidity = sample.humidity;
+    uint32_t age_us = _recordAge(sample.timestamp_us);
+    if (ages_us) {
+      ages_us[count] = age_us;
+    }
+    if (deltas_ms) {
+      uint32_t delta_ms = (sample.timestamp_us - _batch_last_us) / 1000;
+      deltas_ms[count] = (delta_ms > 0xFFFF) ? 0xFFFF : delta_ms;
+    }
+    _batch_last_us = sample.timestamp_us;
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Converts an array of raw records to hundredths of a degree C and
+ * hundredths of a percent RH with integer math only
+ *
+ * @param records The raw records from `readBatch()`
+ * @param count The number of records
+ * @param temperatures Array of `count` entries for the temperatures, or NULL
+ * @param humidities Array of `count` entries for the humidities, or NULL
+ */
+void Adafruit_HTS221::convertBatch(const hts221_raw_record_t *records,
+                                   uint16_t count, int16_t *temperatures,
+                                   int16_t *humidities) {
+  if (temperatures) {
+    for (uint16_t i = 0; i < count; i++) {
+      temperatures[i] =
+          hts221_centiTemperature(&_coeffs, records[i].temperature);
+    }
+  }
+  if (humidities) {
+    for (uint16_t i = 0; i < count; i++) {
+      humidities[i] = hts221_centiHumidity(&_coeffs, records[i].humidity);
+    }
+  }
+}
+
+/**
+ * @brief Converts an array of raw records to degrees C and percent RH
+ *
+ * @param records The raw records from `readBatch()`
+ * @param count The number of records
+ * @param temperatures Array of `count` entries for the temperatures, or NULL
+ * @param humidities Array of `count` entries for the humidities, or NULL
+ */
+void Adafruit_HTS221::convertBatch(const hts221_raw_record_t *records,
+                                   uint16_t count, float *temperatures,
+                                   float *humidities) {
+  if (temperatures) {
+    for (uint16_t i = 0; i < count; i++) {
+      temperatures[i] = hts221_rawToFloat(
+          _coeffs.temp_scale, _coeffs.temp_offset, records[i].temperature);
+    }
+  }
+  if (humidities) {
+    for (uint16_t i = 0; i < count; i++) {
+      humidities[i] = hts221_rawToFloat(
+          _coeffs.humidity_scale, _coeffs.humidity_offset, records[i].humidity);
+    }
+  }
+}
+
+/**
+ * @brief Gets how often readings were served from the last sample instead of
+ * reading the sensor
+ *
+ * @param hits Set to the number of reads answered without bus traffic
+ * @param misses Set to the number of reads that went to the sensor
+ */
+void Adafruit_HTS221::getCacheStats(uint32_t *hits, uint32_t *misses) {
+  *hits = _cache_hits;
+  *misses = _cache_misses;
+}
+
+/**
+ * @brief Clears the counters returned by `getCacheStats()`
+ *
+ */
+void Adafruit_HTS221::resetCacheStats(void) {
+  _cache_hits = 0;
+  _cache_misses = 0;
+}
+
+/**
+ * @brief Starts collecting the bus and timing counters into caller storage,
+ * which is cleared. They are only counted when the library is built with
+ * HTS221_ENABLE_STATS set to 1; without storage nothing is kept at all.
+ *
+ * @param stats The counters to update; NULL to stop collecting
+ */
+void Adafruit_HTS221::setStats(hts221_stats_t *stats) {
+  if (stats) {
+    memset(stats, 0, sizeof(*stats));
+  }
+  _stats = stats;
+}
+
+/**
+ * @brief Gets the bus and timing counters
+ *
+ * @param stats Set to the counters since `setStats()` or `resetStats()`,
+ * or zeroed if none are being collected
+ * @return true if statistics are compiled in and being collected
+ */
+bool Adafruit_HTS221::getStats(hts221_stats_t *stats) {
+#if HTS221_ENABLE_STATS
+  if (_stats) {
+    *stats = *_stats;
+    return true;
+  }
+#endif
+  memset(stats, 0, sizeof(*stats));
+  return false;
+}
+
+/**
+ * @brief Clears the counters returned by `getStats()`
+ *
+ */
+void Adafruit_HTS221::resetStats(void) {
+  if (_stats) {
+    memset(_stats, 0, sizeof(*_stats));
+  }
+}
+
+/*!
+ *  @brief  Fetches the status and raw output registers without converting
+ *
+    @returns true if the registers were read successfully
+ */
+bool Adafruit_HTS221::_readRaw(void) {
+  // STATUS_REG is followed by HUMIDITY_OUT_L/H and TEMP_OUT_L/H, so a single
+  // auto-incrementing burst gets the data ready flags and both samples
+  uint8_t buffer[5];
+  // taken before the read so the bus time doesn't delay the timestamp, and
+  // any DRDY edge is taken first so one arriving during the read isn't lost
+  uint32_t read_us = micros();
+  noInterrupts();
+  bool edge = _drdy_pending;
+  uint32_t edge_us = _drdy_us;
+  _drdy_pending = false;
+  interrupts();
+  if (!_readRegisters(HTS221_STATUS_REG, buffer, 5)) {
+    _status = 0;
+    return false;
+  }
+
+  _status = buffer[0];
+  uint8_t ready = _status & (HTS221_STATUS_H_DA | HTS221_STATUS_T_DA);
+  if (!ready) {
+#if HTS221_ENABLE_STATS
+    if (_stats) {
+      _stats->stale_reads++;
+    }
+#endif
+    _stale_us = read_us;
+    _last_read_stale = true;
+    return true;
+  }
+  if (ready & HTS221_STATUS_H_DA) {
+    _unfiltered_humidity = (int16_t)_le16(&buffer[1]);
+  }
+  if (ready & HTS221_STATUS_T_DA) {
+    _unfiltered_temp = (int16_t)_le16(&buffer[3]);
+  }
+  _oneshot_waiting &= ~ready;
+
+  // the sample was converted at the DRDY edge if there was one. Otherwise
+  // it was converted since the last stale read, and within the last period
+  // when running continuously, so take the middle of that window
+  uint32_t period_us = _ratePeriodUs(getDataRate());
+  if (edge && (!period_us || read_us - edge_us < period_us)) {
+    _converted_us = edge_us;
+  } else {
+    uint32_t window_us = _last_read_stale ? read_us - _stale_us : period_us;
+    if (period_us && window_us > period_us) {
+      window_us = period_us;
+    }
+    _converted_us = read_us - window_us / 2;
+  }
+  _last_read_stale = false;
+  _sample_us = micros();
+
+  if (_filter) {
+    hts221_raw_sample_t sample;
+    sample.timestamp_us = _converted_us;
+    sample.temperature = _unfiltered_temp;
+    sample.humidity = _unfiltered_humidity;
+    if (!_filter->process(&sample)) {
+      // held back by the decimation; clearing the data ready bits makes
+      // the last filtered sample stay current everywhere
+      _status &= ~ready;
+      return true;
+    }
+    raw_temperature = (uint16_t)sample.temperature;
+    raw_humidity = (uint16_t)sample.humidity;
+    ready = HTS221_STATUS_H_DA | HTS221_STATUS_T_DA;
+    _status |= ready;
+  } else {
+    raw_humidity = (uint16_t)_unfiltered_humidity;
+    raw_temperature = (uint16_t)_unfiltered_temp;
+  }
+  _unconverted |= ready;
+  _have_sample = true;
+
+  // while capturing, every new sample is queued here, whichever call read
+  // it, so a getEvent() or readCenti() between edges doesn't lose one
+  if (_capture) {
+    hts221_raw_sample_t sample;
+    sample.timestamp_us = _converted_us;
+    sample.temperature = (int16_t)raw_temperature;
+    sample.humidity = (int16_t)raw_humidity;
+    if (!_capture->push(&sample)) {
+      _dropped_samples++;
+    }
+  }
   return true;
 }
-void Adafruit_HTS221::_fetchTempCalibrationValues(void) {
-  Adafruit_BusIO_Register t0_degc_x8_l =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_T0_DEGC_X8 | multi_byte_address_mask), 2);
-  Adafruit_BusIO_Register t1_t0_msb =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_T1_T0_MSB | multi_byte_address_mask), 1);
-  Adafruit_BusIO_Register to_out =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_T0_OUT | multi_byte_address_mask), 2);
-  Adafruit_BusIO_Register t1_out =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_T1_OUT | multi_byte_address_mask), 2);
-  // From page 26 of https://www.st.com/resource/en/datasheet/hts221.pdf
-  uint8_t buffer[4];
-  // Get bytes for and assemble T0 and T1
-  t1_t0_msb.read(buffer, 1);
-  // mask out the MSBs for each value and shift up to T1[8:9]
-  T0 = 0;
-  T1 = 0;
-  T1 = (buffer[0] & 0b1100);
-  T1 <<= 6;
-  T0 = (buffer[0] & 0b0011);
-  T0 <<= 8;
-
-  t0_degc_x8_l.read(buffer, 2);
-  //  Or T1[0:7] on to the above to make a full 10 bits
-  T0 |= buffer[0];
-  T0 >>= 3; // divide by 8 (as documented)
-  T1 |= buffer[1];
-  T1 >>= 3;
-
-  to_out.read(&T0_OUT);
-  t1_out.read(&T1_OUT);
-}
-
-void Adafruit_HTS221::_fetchHumidityCalibrationValues(void) {
-  Adafruit_BusIO_Register h0_rh_x2 =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_H0_RH_X2 | multi_byte_address_mask), 1);
-  Adafruit_BusIO_Register h1_rh_x2 =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_H1_RH_X2 | multi_byte_address_mask), 1);
-
-  Adafruit_BusIO_Register h0_t0_out =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_H0_T0 | multi_byte_address_mask), 2);
-
-  Adafruit_BusIO_Register h1_t0_out =
-      Adafruit_BusIO_Register(i2c_dev, spi_dev, ADDRBIT8_HIGH_TOREAD,
-                              (HTS221_H0_T1 | multi_byte_address_mask), 2);
-
-  h0_rh_x2.read(&H0);
-  h1_rh_x2.read(&H1);
-
-  h0_t0_out.read(&H0_T0_OUT);
-  h1_t0_out.read(&H1_T0_OUT);
+
+/**
+ * @brief Loads the factory calibration values with a single auto-incrementing
+ * read of the whole 0x30-0x3F calibration block
+ *
+ * @return true if the calibration block was read successfully
+ */
+bool Adafruit_HTS221::_fetchCalibrationValues(void) {
+  uint8_t buffer[HTS221_CAL_BLOCK_LEN];
+  if (!_readRegisters(HTS221_H0_RH_X2, buffer, HTS221_CAL_BLOCK_LEN)) {
+    return false;
+  }
+  hts221_calibration_t calibration;
+  hts221_parseCalibration(buffer, &calibration);
+  return _loadCalibration(&calibration);
 }
 
 /**
- * @brief Use the temperature calibration values to correct the raw value
+ * @brief Copies the decoded calibration values into a blob that can be saved
+ * and passed back to `begin_I2C()` or `begin_SPI()` for a faster start
  *
+ * @param calibration The calibration blob to fill
+ * @return true if the sensor's calibration has been loaded by a successful
+ * begin and the blob was filled
  */
-void Adafruit_HTS221::_applyTemperatureCorrection(void) {
+bool Adafruit_HTS221::getCalibration(hts221_calibration_t *calibration) {
+  if (!_calibrated) {
+    return false;
+  }
+  memset(calibration, 0, sizeof(hts221_calibration_t));
+  calibration->chip_id = HTS221_CHIP_ID;
+  calibration->h0_rh_x2 = H0;
+  calibration->h1_rh_x2 = H1;
+  calibration->t0_degc = T0;
+  calibration->t1_degc = T1;
+  calibration->t0_out = T0_OUT;
+  calibration->t1_out = T1_OUT;
+  calibration->h0_t0_out = H0_T0_OUT;
+  calibration->h1_t0_out = H1_T0_OUT;
+  calibration->crc = hts221_calibrationCRC(calibration);
+  return true;
+}
 
-  // info from
-  // https://www.st.com/resource/en/datasheet/hts221.pdf
-  // Derived from
-  // https://github.com/stm32duino/HTS221/blob/b645af37c51c40b0161ea045e11f9f1bc28b8517/src/HTS221_Driver.c#L396
+/**
+ * @brief Uses saved calibration values instead of reading them from the
+ * sensor
+ *
+ * @param calibration The saved calibration; may be NULL
+ * @return true if the calibration is intact and for this chip and was loaded
+ */
+bool Adafruit_HTS221::_loadCalibration(
+    const hts221_calibration_t *calibration) {
+  if (!calibration || calibration->chip_id != HTS221_CHIP_ID ||
+      calibration->crc != hts221_calibrationCRC(calibration)) {
+    return false;
+  }
+  H0 = calibration->h0_rh_x2;
+  H1 = calibration->h1_rh_x2;
+  T0 = calibration->t0_degc;
+  T1 = calibration->t1_degc;
+  T0_OUT = calibration->t0_out;
+  T1_OUT = calibration->t1_out;
+  H0_T0_OUT = calibration->h0_t0_out;
+  H1_T0_OUT = calibration->h1_t0_out;
+  hts221_computeCoeffs(calibration, &_coeffs);
+  _calibrated = true;
+  return true;
+}
 
-  // I think this can have the consts that are loaded on init factored out to
-  // make a simple LSB value
-  corrected_temp =
-      (float)
-          // measured temp(LSB) - offset(LSB) * (calibration measurement delta)
-          (float)((int16_t)raw_temperature - (int16_t)T0_OUT) *
-          (float)((int16_t)T1 - (int16_t)T0) / // divided by..
-          // Calibration LSB delta + Calibration offset?
-          (float)((int16_t)T1_OUT - (int16_t)T0_OUT) +
-      (int16_t)T0;
+/**
+ * @brief Use the temperature calibration values to correct the raw value
+ *
+ */
+void Adafruit_HTS221::_applyTemperatureCorrection(void) {
+  corrected_temp = hts221_rawToFloat(_coeffs.temp_scale, _coeffs.temp_offset,
+                                     (int16_t)raw_temperature);
 }
 
 /**
@@ -415,23 +1552,247 @@ void Adafruit_HTS221::_applyTemperatureCorrection(void) {
  *
  */
 void Adafruit_HTS221::_applyHumidityCorrection(void) {
+  corrected_humidity =
+      hts221_rawToFloat(_coeffs.humidity_scale, _coeffs.humidity_offset,
+                        (int16_t)raw_humidity);
+}
+
+/**
+ * @brief Reads the sensor and returns the results as integers without any
+ * floating point math
+ *
+ * @param temperature Set to the temperature in hundredths of a degree C
+ * @param humidity Set to the relative humidity in hundredths of a percent
+ * @param age_us Optional; set to how old the sample is, in microseconds
+ * @return true if the data was read successfully; false until the sensor
+ * has produced its first sample
+ */
+bool Adafruit_HTS221::readCenti(int16_t *temperature, int16_t *humidity,
+                                uint32_t *age_us) {
+  if (!_fetchSample() || !_have_sample) {
+    return false;
+  }
+  *temperature = hts221_centiTemperature(&_coeffs, (int16_t)raw_temperature);
+  *humidity = hts221_centiHumidity(&_coeffs, (int16_t)raw_humidity);
+  uint32_t age = _recordAge(_converted_us);
+  if (age_us) {
+    *age_us = age;
+  }
+  return true;
+}
+
+// rounds a reading to hundredths, limited to what an int16_t holds
+static int32_t _watchCenti(float value) {
+  float centi = value * 100;
+  if (centi > 32767) {
+    return 32767;
+  }
+  if (centi < -32768) {
+    return -32768;
+  }
+  return (int32_t)(centi < 0 ? centi - 0.5f : centi + 0.5f);
+}
+
+// division rounding toward minus infinity
+static int32_t _floorDiv(int32_t num, int32_t den) {
+  int32_t quotient = num / den;
+  if ((num % den) && ((num < 0) != (den < 0))) {
+    quotient--;
+  }
+  return quotient;
+}
+
+/**
+ * @brief Sets up threshold and change detection that runs on the raw
+ * counts. The thresholds and deadbands are converted to counts here, once,
+ * so `checkWatch()` only compares integers and converts a sample only when
+ * it has something to report.
+ *
+ * @param watch The thresholds, deadbands and which checks to make
+ * @return true if the sensor is initialized and the watch was set
+ */
+bool Adafruit_HTS221::setWatch(const hts221_watch_t *watch) {
+  if ((!i2c_dev && !spi_dev) || !_coeffs.temp_scale ||
+      !_coeffs.humidity_scale) {
+    return false;
+  }
+  _setWatchChannel(&_watch_temp, _coeffs.temp_scale, _coeffs.temp_offset,
+                   watch->temp_threshold, watch->temp_deadband);
+  _setWatchChannel(&_watch_humid, _coeffs.humidity_scale,
+                   _coeffs.humidity_offset, watch->humidity_threshold,
+                   watch->humidity_deadband);
+  _watch_enable = watch->enable;
+  _watch_primed = false;
+  return true;
+}
+
+/**
+ * @brief Reads the sensor if a new sample could be ready and checks it
+ * against the watch set with `setWatch()`, comparing raw counts only. The
+ * first check after `setWatch()` records the starting point and reports
+ * nothing. A deadband is measured from the reading at the last report of
+ * that channel.
+ *
+ * @param humidity Optional event to fill with the humidity when something
+ * is reported
+ * @param temp Optional event to fill with the temperature when something is
+ * reported
+ * @return uint8_t The HTS221_WATCH_* bits of the checks that fired, or 0
+ */
+uint8_t Adafruit_HTS221::checkWatch(sensors_event_t *humidity,
+                                    sensors_event_t *temp) {
+  if (!_watch_enable || !_fetchSample() || !_have_sample) {
+    return 0;
+  }
+  int16_t raw_temp = (int16_t)raw_temperature;
+  int16_t raw_humid = (int16_t)raw_humidity;
+  if (!_watch_primed) {
+    _watch_temp.above = _watchAbove(&_watch_temp, raw_temp);
+    _watch_temp.reported = raw_temp;
+    _watch_humid.above = _watchAbove(&_watch_humid, raw_humid);
+    _watch_humid.reported = raw_humid;
+    _watch_primed = true;
+    return 0;
+  }
+
+  uint8_t events =
+      _checkWatchChannel(&_watch_temp, raw_temp, _watch_enable,
+                         HTS221_WATCH_TEMP_CROSSED, HTS221_WATCH_TEMP_MOVED) |
+      _checkWatchChannel(&_watch_humid, raw_humid, _watch_enable,
+                         HTS221_WATCH_HUMIDITY_CROSSED,
+                         HTS221_WATCH_HUMIDITY_MOVED);
+  if (!events) {
+    return 0;
+  }
+
+  // only now is anything converted
+  _convertNew();
+  uint32_t t = _sampleMillis();
+  if (temp) {
+    fillTempEvent(temp, t);
+  }
+  if (humidity) {
+    fillHumidityEvent(humidity, t);
+  }
+  return events;
+}
+
+/**
+ * @brief Converts one channel of a watch to raw counts by inverting the
+ * channel's conversion, `(raw * scale + offset) >> HTS221_CAL_SHIFT`
+ *
+ * @param channel The channel to set
+ * @param scale The channel's conversion scale
+ * @param offset The channel's conversion offset
+ * @param threshold The threshold in degrees C or %RH
+ * @param deadband The deadband in degrees C or %RH
+ */
+void Adafruit_HTS221::_setWatchChannel(watch_channel_t *channel,
+                                       int32_t scale, int32_t offset,
+                                       float threshold, float deadband) {
+  // a reading is at or past the threshold when raw * scale + offset >=
+  // threshold << HTS221_CAL_SHIFT; solve that for raw
+  int32_t limit = _watchCenti(threshold) * (1L << HTS221_CAL_SHIFT) - offset;
+  if (scale > 0) {
+    channel->threshold = -_floorDiv(-limit, scale); // rounded up
+    channel->direction = 1;
+  } else {
+    channel->threshold = _floorDiv(limit, scale);
+    channel->direction = -1;
+  }
+  int32_t band = _watchCenti(deadband);
+  channel->deadband = (uint32_t)(band < 0 ? 0 : band) *
+                      (1UL << HTS221_CAL_SHIFT) /
+                      (uint32_t)(scale < 0 ? -scale : scale);
+}
 
-  // Derived from
-  // https://github.com/ameltech/sme-hts221-library/blob/2fe7528f4d42b4b36b39d9f6db76aae25ebe300b/src/Humidity/HTS221.cpp#L185
+/**
+ * @brief Finds which side of a watch's threshold a raw count is on
+ *
+ * @param channel The watch channel
+ * @param raw The raw count
+ * @return true if the reading is at or past the threshold
+ */
+bool Adafruit_HTS221::_watchAbove(const watch_channel_t *channel,
+                                  int16_t raw) {
+  return ((int32_t)raw - channel->threshold) * channel->direction >= 0;
+}
 
-  // uint8_t data = 0;
-  // uint16_t h_out = 0;
-  float h_temp = 0.0;
-  float hum = 0.0;
+/**
+ * @brief Checks a raw count against one watch channel
+ *
+ * @param channel The watch channel; its state is updated
+ * @param raw The new raw count
+ * @param enable The HTS221_WATCH_* checks being made
+ * @param crossed The channel's threshold bit
+ * @param moved The channel's deadband bit
+ * @return uint8_t The channel's bits that fired
+ */
+uint8_t Adafruit_HTS221::_checkWatchChannel(watch_channel_t *channel,
+                                            int16_t raw, uint8_t enable,
+                                            uint8_t crossed, uint8_t moved) {
+  uint8_t events = 0;
+  bool above = _watchAbove(channel, raw);
+  if (above != channel->above) {
+    events |= crossed;
+  }
+  channel->above = above;
+  int32_t change = (int32_t)raw - channel->reported;
+  if ((uint32_t)(change < 0 ? -change : change) > channel->deadband) {
+    events |= moved;
+  }
+  events &= enable;
+  if (events) {
+    channel->reported = raw;
+  }
+  return events;
+}
 
-  // Decode Humidity
-  hum = ((int16_t)(H1) - (int16_t)(H0)) / 2.0; // remove x2 multiple
+/**
+ * @brief Gets when the current reading was converted by the sensor. This is
+ * the DRDY edge if `dataReady()` is being called from the pin's interrupt.
+ * Otherwise it is estimated from when STATUS_REG was seen to change: the
+ * middle of the time between the last read that found no new data and the
+ * read that did, capped to one output period. Polling faster than the data
+ * rate tightens the estimate.
+ *
+ * @return uint32_t micros() at the time the sample was converted
+ */
+uint32_t Adafruit_HTS221::getSampleTime(void) { return _converted_us; }
+
+/**
+ * @brief Gets how long ago the current reading was converted by the sensor
+ *
+ * @return uint32_t The age of the reading in microseconds
+ */
+uint32_t Adafruit_HTS221::getSampleAge(void) {
+  return (uint32_t)micros() - _converted_us;
+}
 
-  // Calculate humidity in decimal of grade centigrades i.e. 15.0 = 150.
-  h_temp = (float)(((int16_t)raw_humidity - (int16_t)H0_T0_OUT) * hum) /
-           (float)((int16_t)H1_T0_OUT - (int16_t)H0_T0_OUT);
-  hum = (float)((int16_t)H0) / 2.0;    // remove x2 multiple
-  corrected_humidity = (hum + h_temp); // provide signed % measurement unit
+/**
+ * @brief Runs every new sample through a filter before it is used. The
+ * filter works on the raw counts, so samples dropped by its decimation are
+ * never converted, captured or returned by `readBatch()`; readings stay at
+ * the last filtered sample until the next one comes out.
+ *
+ * @param filter The filter, which is reset; NULL to stop filtering
+ */
+void Adafruit_HTS221::setFilter(Adafruit_HTS221_Filter *filter) {
+  if (filter) {
+    filter->reset();
+  }
+  _filter = filter;
+}
+
+/**
+ * @brief Gets the fixed-point conversion coefficients for this sensor, for
+ * use with `hts221_centiTemperature()` and `hts221_centiHumidity()`
+ *
+ * @return const hts221_coeffs_t* The coefficients folded from the sensor's
+ * calibration
+ */
+const hts221_coeffs_t *Adafruit_HTS221::getCoefficients(void) {
+  return &_coeffs;
 }
 
 /**
@@ -473,12 +1834,18 @@ void Adafruit_HTS221_Humidity::getSensor(sensor_t *sensor) {
 }
 /**
     @brief  Gets the humidity as a standard sensor event
-    @param  event Sensor event object that will be populated
-    @returns True
+    @param  event Sensor event object that will be populated; on failure it
+    is cleared apart from its header and the current time
+    @returns true if the event data was read successfully
  */
 bool Adafruit_HTS221_Humidity::getEvent(sensors_event_t *event) {
-  _theHTS221->_read();
-  _theHTS221->fillHumidityEvent(event, millis());
+  if (!_theHTS221->_read()) {
+    // an empty event rather than whatever the caller's buffer held
+    _theHTS221->fillHumidityEvent(event, millis());
+    event->relative_humidity = 0;
+    return false;
+  }
+  _theHTS221->fillHumidityEvent(event, _theHTS221->_sampleMillis());
 
   return true;
 }
@@ -504,12 +1871,83 @@ void Adafruit_HTS221_Temp::getSensor(sensor_t *sensor) {
 }
 /*!
     @brief  Gets the temperature as a standard sensor event
-    @param  event Sensor event object that will be populated
-    @returns true
+    @param  event Sensor event object that will be populated; on failure it
+    is cleared apart from its header and the current time
+    @returns true if the event data was read successfully
 */
 bool Adafruit_HTS221_Temp::getEvent(sensors_event_t *event) {
-  _theHTS221->_read();
-  _theHTS221->fillTempEvent(event, millis());
+  if (!_theHTS221->_read()) {
+    // an empty event rather than whatever the caller's buffer held
+    _theHTS221->fillTempEvent(event, millis());
+    event->temperature = 0;
+    return false;
+  }
+  _theHTS221->fillTempEvent(event, _theHTS221->_sampleMillis());
 
   return true;
 }
+
+/**
+ * @brief Creates a sample queue in caller provided storage
+ *
+ * @param storage The array samples are kept in
+ * @param capacity The number of entries in `storage`; one is kept free to
+ * tell a full queue from an empty one
+ */
+Adafruit_HTS221_SampleBuffer::Adafruit_HTS221_SampleBuffer(
+    hts221_raw_sample_t *storage, uint8_t capacity) {
+  _storage = storage;
+  _capacity = capacity;
+}
+
+/**
+ * @brief Adds a sample. Only call from the producer side.
+ *
+ * @param sample The sample to copy in
+ * @return true if there was room for the sample
+ */
+bool Adafruit_HTS221_SampleBuffer::push(const hts221_raw_sample_t *sample) {
+  uint8_t head = _head;
+  uint8_t next = (head + 1 == _capacity) ? 0 : head + 1;
+  if (next == _tail) {
+    return false;
+  }
+  _storage[head] = *sample;
+  // the sample has to be stored before the consumer can see the new head
+  asm volatile("" ::: "memory");
+  _head = next;
+  return true;
+}
+
+/**
+ * @brief Removes up to `max_samples` of the oldest samples. Only call from
+ * the consumer side.
+ *
+ * @param samples Where to copy the samples to
+ * @param max_samples The most samples to copy
+ * @return uint8_t The number of samples copied
+ */
+uint8_t Adafruit_HTS221_SampleBuffer::pop(hts221_raw_sample_t *samples,
+                                          uint8_t max_samples) {
+  uint8_t tail = _tail;
+  uint8_t head = _head;
+  uint8_t count = 0;
+  while (tail != head && count < max_samples) {
+    samples[count++] = _storage[tail];
+    tail = (tail + 1 == _capacity) ? 0 : tail + 1;
+  }
+  asm volatile("" ::: "memory");
+  _tail = tail;
+  return count;
+}
+
+/**
+ * @brief Gets the number of samples waiting to be popped
+ *
+ * @return uint8_t The number of queued samples
+ */
+uint8_t Adafruit_HTS221_SampleBuffer::available(void) {
+  uint8_t head = _head;
+  uint8_t tail = _tail;
+  return (head >= tail) ? head - tail : _capacity - tail + head;
+}
@@ -18,6 +18,8 @@
 #ifndef _ADAFRUIT_HTS221_H
 #define _ADAFRUIT_HTS221_H
 
+#include "Adafruit_HTS221_Convert.h"
+#include "Adafruit_HTS221_Filter.h"
 #include "Arduino.h"
 #include <Adafruit_BusIO_Register.h>
 #include <Adafruit_I2CDevice.h>
@@ -26,23 +28,47 @@
 #include <Wire.h>
 
 #define HTS221_I2CADDR_DEFAULT 0x5F ///< HTS221 default i2c address
-#define HTS221_CHIP_ID 0xBC         ///< HTS221 default device id from WHOAMI
+#define HTS221_AV_CONF 0x10         ///< Humidity and temperature averaging
 #define HTS221_CTRL_REG_1 0x20      ///< First control regsiter; PD, OBDU, ODR
 #define HTS221_CTRL_REG_2                                                      \
   0x21 ///< Second control regsiter; BOOT, Heater, ONE_SHOT
 #define HTS221_CTRL_REG_3 0x22   ///< Third control regsiter; DRDY_H_L, DRDY
+#define HTS221_STATUS_REG 0x27   ///< Status register; H_DA, T_DA
 #define HTS221_HUMIDITY_OUT 0x28 ///< Humidity output register (LSByte)
 #define HTS221_TEMP_OUT_L 0x2A   ///< Temperature output register (LSByte)
 #define HTS221_H0_RH_X2 0x30     ///< Humididy calibration LSB values
 #define HTS221_H1_RH_X2 0x31     ///< Humididy calibration LSB values
 #define HTS221_T0_DEGC_X8 0x32   ///< First byte of T0, T1 calibration values
+#define HTS221_T1_DEGC_X8 0x33   ///< First byte of T1 calibration value
 #define HTS221_T1_T0_MSB 0x35    ///< Top 2 bits of T0 and T1 (each are 10 bits)
 #define HTS221_H0_T0 0x36        ///< Humididy calibration Time 0 value
 #define HTS221_H0_T1 0x3A        ///< Humididy calibration Time 1 value
 #define HTS221_T0_OUT 0x3C       ///< T0_OUT LSByte
 #define HTS221_T1_OUT 0x3E       ///< T1_OUT LSByte
 
+#define HTS221_SPI_DEFAULT_FREQ 1000000 ///< Default SPI clock in Hz
+#define HTS221_SPI_MAX_FREQ 10000000    ///< Fastest SPI clock in Hz
+
+#define HTS221_SAMPLE_TIMEOUT_MS 100 ///< Longest wait for a requested sample
+#define HTS221_BOOT_TIMEOUT_MS 50    ///< Longest wait for BOOT to clear
+
 #define HTS221_WHOAMI 0x0F ///< Chip ID register
+
+#define HTS221_STATUS_H_DA 0x02 ///< STATUS_REG bit: new humidity data ready
+#define HTS221_STATUS_T_DA 0x01 ///< STATUS_REG bit: new temperature data ready
+
+#define HTS221_CTRL_1_PD 0x80       ///< CTRL_REG1 bit: active (power down off)
+#define HTS221_CTRL_1_BDU 0x04      ///< CTRL_REG1 bit: block data update
+#define HTS221_CTRL_1_ODR 0x03      ///< CTRL_REG1 bits: output data rate
+#define HTS221_CTRL_2_BOOT 0x80     ///< CTRL_REG2 bit: reboot memory content
+#define HTS221_CTRL_2_HEATER 0x02   ///< CTRL_REG2 bit: heater enable
+#define HTS221_CTRL_2_ONE_SHOT 0x01 ///< CTRL_REG2 bit: start a one shot
+#define HTS221_CTRL_3_DRDY_H_L 0x80 ///< CTRL_REG3 bit: DRDY active low
+#define HTS221_CTRL_3_PP_OD 0x40    ///< CTRL_REG3 bit: DRDY open drain
+#define HTS221_CTRL_3_DRDY_EN 0x04  ///< CTRL_REG3 bit: DRDY enable
+#define HTS221_AV_CONF_DEFAULT 0x1B ///< AV_CONF reset value
+#define HTS221_AV_CONF_AVGT 0x38    ///< AV_CONF bits: temperature averaging
+#define HTS221_AV_CONF_AVGH 0x07    ///< AV_CONF bits: humidity averaging
 /**
  * @brief
  *
@@ -55,6 +81,179 @@ typedef enum {
   HTS221_RATE_12_5_HZ,
 } hts221_rate_t;
 
+/**
+ * @brief A complete sensor configuration, applied in one go with
+ * `configure()`
+ */
+typedef struct {
+  bool active;             ///< Power on and run conversions
+  hts221_rate_t data_rate; ///< Output data rate
+  bool block_data_update;  ///< Don't update outputs until both bytes are read
+  bool heater;             ///< Turn on the internal heater
+  bool drdy_active_low;    ///< DRDY pin is active low
+  bool drdy_open_drain;    ///< DRDY pin is open drain instead of push-pull
+  bool drdy_int_enabled;   ///< Signal data ready on the DRDY pin
+  uint8_t averaging;       ///< Raw AV_CONF register value
+} hts221_config_t;
+
+/**
+ * @brief Progress of a non-blocking init started with `startBegin_I2C()` or
+ * `startBegin_SPI()`, as returned by `pollBegin()`
+ */
+typedef enum {
+  HTS221_BEGIN_IDLE,  ///< No non-blocking init has been started
+  HTS221_BEGIN_BUSY,  ///< Still working; keep calling `pollBegin()`
+  HTS221_BEGIN_READY, ///< The sensor is initialized and ready to read
+  HTS221_BEGIN_ERROR, ///< No response, not an HTS221, or boot timed out
+} hts221_begin_status_t;
+
+/**
+ * @brief Progress of a read started with `requestSample()`, as returned by
+ * `pollSample()`
+ */
+typedef enum {
+  HTS221_SAMPLE_IDLE,  ///< No read has been requested
+  HTS221_SAMPLE_BUSY,  ///< Still working; keep calling `pollSample()`
+  HTS221_SAMPLE_READY, ///< The reading is ready
+  HTS221_SAMPLE_ERROR, ///< The sensor didn't respond or the sample timed out
+} hts221_sample_status_t;
+
+/**
+ * @brief A converted reading delivered by `pollSample()`
+ */
+typedef struct {
+  uint32_t timestamp_us; ///< micros() when the sensor converted the sample
+  uint32_t age_us;       ///< How old the sample was when it was handed over
+  int16_t temperature;   ///< Temperature in hundredths of a degree C
+  int16_t humidity;      ///< Relative humidity in hundredths of a percent
+} hts221_reading_t;
+
+/** Called from `pollSample()` when a requested reading is ready */
+typedef void (*hts221_reading_callback_t)(const hts221_reading_t *reading);
+
+/**
+ * @brief Number of internal temperature samples averaged per output, for
+ * `setTemperatureAveraging()`
+ */
+typedef enum {
+  HTS221_TEMP_AVG_2,
+  HTS221_TEMP_AVG_4,
+  HTS221_TEMP_AVG_8,
+  HTS221_TEMP_AVG_16, ///< Power on default
+  HTS221_TEMP_AVG_32,
+  HTS221_TEMP_AVG_64,
+  HTS221_TEMP_AVG_128,
+  HTS221_TEMP_AVG_256,
+} hts221_temp_avg_t;
+
+/**
+ * @brief Number of internal humidity samples averaged per output, for
+ * `setHumidityAveraging()`
+ */
+typedef enum {
+  HTS221_HUMIDITY_AVG_4,
+  HTS221_HUMIDITY_AVG_8,
+  HTS221_HUMIDITY_AVG_16,
+  HTS221_HUMIDITY_AVG_32, ///< Power on default
+  HTS221_HUMIDITY_AVG_64,
+  HTS221_HUMIDITY_AVG_128,
+  HTS221_HUMIDITY_AVG_256,
+  HTS221_HUMIDITY_AVG_512,
+} hts221_humidity_avg_t;
+
+/**
+ * @brief Averaging and data rate picked by `planProfile()`, with the
+ * datasheet's figures for them
+ */
+typedef struct {
+  hts221_temp_avg_t temp_averaging;         ///< Temperature averaging
+  hts221_humidity_avg_t humidity_averaging; ///< Humidity averaging
+  hts221_rate_t data_rate;                  ///< Output data rate
+  float temp_noise;     ///< Expected temperature noise, degrees C RMS
+  float humidity_noise; ///< Expected humidity noise, %RH RMS
+  float current_ua;     ///< Estimated supply current in uA; per sample per
+                        ///< second for one shot
+} hts221_profile_t;
+
+#ifndef HTS221_ENABLE_STATS
+/** Set to 1, for example with a build flag, to collect the `getStats()`
+ * counters. Left at 0 the counting code is compiled out. The counters live
+ * in caller storage passed to `setStats()`, and the class only keeps a
+ * pointer to them, so its layout doesn't depend on the flag */
+#define HTS221_ENABLE_STATS 0
+#endif
+
+#define HTS221_LATENCY_BINS 12 ///< Bins in `hts221_stats_t::latency`
+
+/**
+ * @brief Bus and timing counters, collected into storage passed to
+ * `setStats()` when HTS221_ENABLE_STATS is 1
+ */
+typedef struct {
+  uint32_t reads;        ///< Readings requested through the getEvent calls
+  uint32_t failed_reads; ///< Readings that failed
+  uint32_t stale_reads;  ///< Sensor reads that found no new data
+  uint32_t transactions; ///< Bus transactions, reads and writes
+  uint32_t bytes;        ///< Bytes moved, counting the register address
+  uint32_t read_us;      ///< Total micros() spent getting readings
+  uint32_t read_max_us;  ///< Longest time spent getting one reading
+  uint32_t bus_us;       ///< Total micros() spent in bus transactions
+  uint32_t bus_max_us;   ///< Longest single bus transaction
+  /** Readings handed out, by the age of their sample: bin n counts ages
+   * under 256 << n us, and the last bin all older ones */
+  uint32_t latency[HTS221_LATENCY_BINS];
+} hts221_stats_t;
+
+#define HTS221_WATCH_TEMP_CROSSED 0x01     ///< Temperature crossed threshold
+#define HTS221_WATCH_HUMIDITY_CROSSED 0x02 ///< Humidity crossed threshold
+#define HTS221_WATCH_TEMP_MOVED 0x04       ///< Temperature left its deadband
+#define HTS221_WATCH_HUMIDITY_MOVED 0x08   ///< Humidity left its deadband
+
+/**
+ * @brief Thresholds and deadbands for `setWatch()`. `enable` picks which of
+ * the four checks are made, and `checkWatch()` returns the same bits for
+ * the checks that fired
+ */
+typedef struct {
+  float temp_threshold;     ///< Report crossings of this temperature, C
+  float humidity_threshold; ///< Report crossings of this humidity, %RH
+  float temp_deadband;      ///< Report temperature moves larger than this, C
+  float humidity_deadband;  ///< Report humidity moves larger than this, %RH
+  uint8_t enable;           ///< HTS221_WATCH_* bits of the checks to make
+} hts221_watch_t;
+
+/**
+ * @brief A compact raw sample for buffering many readings; convert with
+ * `convertBatch()`
+ */
+typedef struct {
+  int16_t temperature; ///< Raw TEMP_OUT value
+  int16_t humidity;    ///< Raw HUMIDITY_OUT value
+} hts221_raw_record_t;
+
+/**
+ * @brief Fixed-capacity single-producer/single-consumer queue of raw samples.
+ *
+ * The HTS221 driver pushes every new sample it reads into it, normally from
+ * `service()`, and the application drains it with `pop()`; neither side
+ * blocks or disables interrupts. Memory comes from the caller so the
+ * capacity can be sized per application.
+ */
+class Adafruit_HTS221_SampleBuffer {
+public:
+  Adafruit_HTS221_SampleBuffer(hts221_raw_sample_t *storage, uint8_t capacity);
+
+  bool push(const hts221_raw_sample_t *sample);
+  uint8_t pop(hts221_raw_sample_t *samples, uint8_t max_samples);
+  uint8_t available(void);
+
+private:
+  hts221_raw_sample_t *_storage; ///< Caller provided sample storage
+  uint8_t _capacity;             ///< Number of slots in the storage
+  volatile uint8_t _head = 0;    ///< Next slot to write; producer only
+  volatile uint8_t _tail = 0;    ///< Next slot to read; consumer only
+};
+
 class Adafruit_HTS221;
 
 /**
@@ -107,9 +306,34 @@ public:
                  TwoWire *wire = &Wire, int32_t sensor_id = 0);
 
   bool begin_SPI(uint8_t cs_pin, SPIClass *theSPI = &SPI,
-                 int32_t sensor_id = 0);
+                 int32_t sensor_id = 0,
+                 uint32_t frequency = HTS221_SPI_DEFAULT_FREQ);
   bool begin_SPI(int8_t cs_pin, int8_t sck_pin, int8_t miso_pin,
-                 int8_t mosi_pin, int32_t sensor_id = 0);
+                 int8_t mosi_pin, int32_t sensor_id = 0,
+                 uint32_t frequency = HTS221_SPI_DEFAULT_FREQ);
+
+  bool begin_I2C(const hts221_calibration_t *calibration,
+                 uint8_t i2c_addr = HTS221_I2CADDR_DEFAULT,
+                 TwoWire *wire = &Wire, int32_t sensor_id = 0);
+  bool begin_SPI(const hts221_calibration_t *calibration, uint8_t cs_pin,
+                 SPIClass *theSPI = &SPI, int32_t sensor_id = 0,
+                 uint32_t frequency = HTS221_SPI_DEFAULT_FREQ);
+
+  bool begin_I2C(Adafruit_I2CDevice *i2c_device,
+                 const hts221_calibration_t *calibration = NULL,
+                 int32_t sensor_id = 0);
+  bool begin_SPI(Adafruit_SPIDevice *spi_device,
+                 const hts221_calibration_t *calibration = NULL,
+                 int32_t sensor_id = 0);
+
+  bool getCalibration(hts221_calibration_t *calibration);
+
+  void startBegin_I2C(uint8_t i2c_addr = HTS221_I2CADDR_DEFAULT,
+                      TwoWire *wire = &Wire, int32_t sensor_id = 0);
+  void startBegin_SPI(uint8_t cs_pin, SPIClass *theSPI = &SPI,
+                      int32_t sensor_id = 0,
+                      uint32_t frequency = HTS221_SPI_DEFAULT_FREQ);
+  hts221_begin_status_t pollBegin(uint32_t *elapsed_us = NULL);
 
   void boot(void);
 
@@ -120,16 +344,71 @@ public:
   void drdyActiveLow(bool active_low);
   void drdyIntEnabled(bool drdy_int_enabled);
 
+  bool configure(const hts221_config_t *config);
+  void getConfig(hts221_config_t *config);
+
+  void setTemperatureAveraging(hts221_temp_avg_t averaging);
+  hts221_temp_avg_t getTemperatureAveraging(void);
+  void setHumidityAveraging(hts221_humidity_avg_t averaging);
+  hts221_humidity_avg_t getHumidityAveraging(void);
+
+  static bool planProfile(float max_temp_noise, float max_humidity_noise,
+                          uint32_t max_latency_ms, hts221_profile_t *profile);
+  bool applyProfile(const hts221_profile_t *profile);
+
   bool getEvent(sensors_event_t *humidity, sensors_event_t *temp);
   Adafruit_Sensor *getTemperatureSensor(void);
   Adafruit_Sensor *getHumiditySensor(void);
 
+  bool readCenti(int16_t *temperature, int16_t *humidity,
+                 uint32_t *age_us = NULL);
+  uint32_t getSampleTime(void);
+  uint32_t getSampleAge(void);
+
+  void setFilter(Adafruit_HTS221_Filter *filter);
+
+  bool setWatch(const hts221_watch_t *watch);
+  uint8_t checkWatch(sensors_event_t *humidity = NULL,
+                     sensors_event_t *temp = NULL);
+
+  bool startOneShot(void);
+  bool pollOneShot(void);
+
+  bool requestSample(hts221_reading_callback_t callback = NULL);
+  hts221_sample_status_t pollSample(hts221_reading_t *reading = NULL);
+
+  void startCapture(Adafruit_HTS221_SampleBuffer *buffer);
+  void stopCapture(void);
+  void dataReady(void);
+  bool service(void);
+  uint32_t getDroppedSamples(void);
+
+  uint16_t readBatch(hts221_raw_record_t *records, uint16_t max_records,
+                     uint16_t *deltas_ms = NULL, uint32_t *ages_us = NULL);
+  void convertBatch(const hts221_raw_record_t *records, uint16_t count,
+                    int16_t *temperatures, int16_t *humidities);
+  void convertBatch(const hts221_raw_record_t *records, uint16_t count,
+                    float *temperatures, float *humidities);
+
+  void getCacheStats(uint32_t *hits, uint32_t *misses);
+  void resetCacheStats(void);
+  void setStats(hts221_stats_t *stats);
+  bool getStats(hts221_stats_t *stats);
+  void resetStats(void);
+  const hts221_coeffs_t *getCoefficients(void);
+
 protected:
   bool _read(void);
-  virtual bool _init(int32_t sensor_id);
+  bool _readRaw(void);
+  bool _fetchSample(void);
+  static uint32_t _ratePeriodUs(hts221_rate_t data_rate);
+  virtual bool _init(int32_t sensor_id,
+                     const hts221_calibration_t *calibration = NULL);
+  bool _boot(void);
 
-  float corrected_temp,   ///< Last reading's temperature (C) before scaling
-      corrected_humidity; ///< Last reading's humidity (percent) before scaling
+  float corrected_temp = 0, ///< Last reading's temperature (C) before scaling
+      corrected_humidity =
+          0; ///< Last reading's humidity (percent) before scaling
 
   uint16_t _sensorid_humidity; ///< ID number for humidity
   uint16_t _sensorid_temp;     ///< ID number for temperature
@@ -142,8 +421,8 @@ protected:
       NULL; ///< Humidity sensor data object
 
 private:
-  void _fetchTempCalibrationValues(void);
-  void _fetchHumidityCalibrationValues(void);
+  bool _fetchCalibrationValues(void);
+  bool _loadCalibration(const hts221_calibration_t *calibration);
   friend class Adafruit_HTS221_Temp;     ///< Gives access to private members to
                                          ///< Temp data object
   friend class Adafruit_HTS221_Humidity; ///< Gives access to private members to
@@ -151,14 +430,110 @@ private:
 
   void fillTempEvent(sensors_event_t *temp, uint32_t timestamp);
   void fillHumidityEvent(sensors_event_t *humidity, uint32_t timestamp);
+  uint32_t _sampleMillis(void);
+  uint32_t _recordAge(uint32_t timestamp_us);
 
   void _applyTemperatureCorrection(void);
   void _applyHumidityCorrection(void);
-  uint16_t T0, T1, T0_OUT, T1_OUT; ///< Temperature calibration values
-  uint8_t H0, H1;                  ///< Humidity calibration values
-  uint16_t H0_T0_OUT, H1_T0_OUT;   ///< Humidity calibration values
-  uint16_t raw_temperature; ///< The raw unscaled, uncorrected temperature value
-  uint16_t raw_humidity;    ///< The raw unscaled, uncorrected humidity value
+  void _convertNew(void);
+  uint16_t T0 = 0, T1 = 0, T0_OUT = 0, T1_OUT = 0; ///< Temperature calibration
+  uint8_t H0 = 0, H1 = 0;                          ///< Humidity calibration
+  uint16_t H0_T0_OUT = 0, H1_T0_OUT = 0;           ///< Humidity calibration
+
+  hts221_coeffs_t _coeffs = {}; ///< Fixed-point form of the calibration values
+  bool _calibrated = false;     ///< The calibration values have been loaded
+  uint16_t raw_temperature =
+      0; ///< The raw unscaled, uncorrected temperature value
+  uint16_t raw_humidity = 0; ///< The raw unscaled, uncorrected humidity value
+
+  int16_t _unfiltered_temp = 0;           ///< Latest TEMP_OUT, unfiltered
+  int16_t _unfiltered_humidity = 0;       ///< Latest HUMIDITY_OUT, unfiltered
+  Adafruit_HTS221_Filter *_filter = NULL; ///< Filter on new samples
+
+  uint8_t _status = 0;          ///< STATUS_REG from the last read
+  uint8_t _unconverted = 0;     ///< Data ready bits not yet converted to float
+  bool _have_sample = false;    ///< A sample has been read since init
+  uint32_t _sample_us = 0;      ///< micros() when the last new sample was read
+  uint32_t _converted_us = 0;   ///< micros() when it was converted
+  uint32_t _cache_hits = 0;     ///< Reads served from the last sample
+  uint32_t _cache_misses = 0;   ///< Reads that went to the sensor
+  uint8_t _oneshot_waiting = 0; ///< Data ready bits a one shot still needs
+  bool _outputs_stale = false;  ///< Continuous mode may have set data ready
+
+  hts221_stats_t *_stats = NULL; ///< Counters set with setStats(), or NULL
+
+  Adafruit_HTS221_SampleBuffer *_capture = NULL; ///< DRDY capture queue
+  volatile bool _drdy_pending = false; ///< A DRDY edge hasn't been serviced
+  volatile uint32_t _drdy_us = 0;      ///< micros() at the last DRDY edge
+  uint32_t _dropped_samples = 0;       ///< Samples lost to a full queue
+  uint32_t _batch_last_us = 0;         ///< Last sample given to readBatch()
+  uint32_t _stale_us = 0;              ///< micros() at the last stale read
+  bool _last_read_stale = false;       ///< The last read found no new data
+
+  bool _writeRegister(uint8_t reg, uint8_t value);
+  bool _readRegisters(uint8_t reg, uint8_t *buffer, uint8_t len);
+  bool _writeRegisters(uint8_t reg, uint8_t *buffer, uint8_t len);
+  void _createSensors(void);
+  void _releaseBus(void);
+
+  Adafruit_HTS221_Temp _temp_sensor;         ///< Storage for temp_sensor
+  Adafruit_HTS221_Humidity _humidity_sensor; ///< Storage for humidity_sensor
+
+  /** Storage the bus device is built in, so begin doesn't allocate */
+  alignas(Adafruit_I2CDevice) alignas(Adafruit_SPIDevice) uint8_t
+      _bus_storage[sizeof(Adafruit_I2CDevice) > sizeof(Adafruit_SPIDevice)
+                       ? sizeof(Adafruit_I2CDevice)
+                       : sizeof(Adafruit_SPIDevice)];
+
+  /** Steps of the non-blocking init, one bus transaction each */
+  enum {
+    BEGIN_STEP_IDLE,
+    BEGIN_STEP_DEVICE,
+    BEGIN_STEP_WHOAMI,
+    BEGIN_STEP_BOOT,
+    BEGIN_STEP_BOOT_WAIT,
+    BEGIN_STEP_AV_CONF,
+    BEGIN_STEP_CONFIG,
+    BEGIN_STEP_CALIBRATION,
+    BEGIN_STEP_READY,
+    BEGIN_STEP_ERROR,
+  };
+  void _startBegin(int32_t sensor_id);
+  uint8_t _begin_step = BEGIN_STEP_IDLE; ///< Current non-blocking init step
+  uint32_t _begin_start_us = 0;   ///< micros() when the init was started
+  uint32_t _begin_elapsed_us = 0; ///< Time taken by the init so far
+  uint32_t _boot_start_ms = 0;    ///< millis() when BOOT was set
+  uint8_t _ctrl_1 = 0;                       ///< Copy of CTRL_REG1
+  uint8_t _ctrl_2 = 0;                       ///< Copy of CTRL_REG2
+  uint8_t _ctrl_3 = 0;                       ///< Copy of CTRL_REG3
+  uint8_t _av_conf = HTS221_AV_CONF_DEFAULT; ///< Copy of AV_CONF
+
+  /** Progress of the read started by `requestSample()` */
+  hts221_sample_status_t _request_status = HTS221_SAMPLE_IDLE;
+  /** Called when the requested reading is ready */
+  hts221_reading_callback_t _request_callback = NULL;
+  uint32_t _request_us = 0;       ///< micros() when the read was requested
+  hts221_reading_t _reading = {}; ///< The requested reading, once ready
+
+  /** One channel of `setWatch()`, in raw counts */
+  typedef struct {
+    int32_t threshold; ///< Raw count where the threshold is reached
+    int8_t direction;  ///< 1 if the counts rise with the reading, else -1
+    uint32_t deadband; ///< Largest raw move that isn't reported
+    int16_t reported;  ///< Raw count at the last report
+    bool above;        ///< The last reading was at or past the threshold
+  } watch_channel_t;
+  watch_channel_t _watch_temp;  ///< Temperature watch, in TEMP_OUT counts
+  watch_channel_t _watch_humid; ///< Humidity watch, in HUMIDITY_OUT counts
+  uint8_t _watch_enable = 0;    ///< HTS221_WATCH_* checks being made
+  bool _watch_primed = false;   ///< The watches have a starting point
+  static void _setWatchChannel(watch_channel_t *channel, int32_t scale,
+                               int32_t offset, float threshold,
+                               float deadband);
+  static bool _watchAbove(const watch_channel_t *channel, int16_t raw);
+  static uint8_t _checkWatchChannel(watch_channel_t *channel, int16_t raw,
+                                    uint8_t enable, uint8_t crossed,
+                                    uint8_t moved);
 
   uint8_t multi_byte_address_mask = 0x80; // default to I2C
 };
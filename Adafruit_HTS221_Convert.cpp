@@ -0,0 +1,228 @@
+/*!
+ *  @file Adafruit_HTS221_Convert.cpp
+ *
+ * 	Calibration decoding and bulk raw to physical unit conversion for the
+ * 	Adafruit HTS221 Humidity and Temperature Sensor library
+ *
+ * 	The loops are kept to a single multiply-add per element with no branches
+ * 	and no aliasing between input and output, so compilers can auto-vectorize
+ * 	them (SSE/AVX on x86, NEON on ARM) when building for a host.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_HTS221_Convert.h"
+#include <string.h>
+
+#if defined(__GNUC__)
+#define HTS221_RESTRICT __restrict__
+#else
+#define HTS221_RESTRICT
+#endif
+
+static void _convertFloat(int32_t scale, int32_t offset,
+                          const int16_t *HTS221_RESTRICT raw,
+                          float *HTS221_RESTRICT out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = hts221_rawToFloat(scale, offset, raw[i]);
+  }
+}
+
+static void _convertCenti(int32_t scale, int32_t offset,
+                          const int16_t *HTS221_RESTRICT raw,
+                          int16_t *HTS221_RESTRICT out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = (int16_t)(((int32_t)raw[i] * scale + offset) >> HTS221_CAL_SHIFT);
+  }
+}
+
+// assembles a little endian 16-bit register pair from the calibration block
+static inline uint16_t _le16(const uint8_t *buffer) {
+  return (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+}
+
+/**
+ * @brief Decodes the factory calibration from the raw register block
+ *
+ * @param block The `HTS221_CAL_BLOCK_LEN` bytes read from registers 0x30-0x3F,
+ * `block[n]` holding register 0x30 + n
+ * @param calibration Set to the decoded calibration, with the chip id and CRC
+ * filled in
+ */
+void hts221_parseCalibration(const uint8_t *block,
+                             hts221_calibration_t *calibration) {
+  // From page 26 of https://www.st.com/resource/en/datasheet/hts221.pdf
+  memset(calibration, 0, sizeof(hts221_calibration_t));
+  calibration->chip_id = HTS221_CHIP_ID;
+  calibration->h0_rh_x2 = block[0x00];
+  calibration->h1_rh_x2 = block[0x01];
+
+  // T0 and T1 are 10 bits; the top two bits of each are in T1_T0_MSB (0x35)
+  uint8_t t1_t0_msb = block[0x05];
+  uint16_t t0 = ((uint16_t)(t1_t0_msb & 0b0011) << 8) | block[0x02];
+  uint16_t t1 = ((uint16_t)(t1_t0_msb & 0b1100) << 6) | block[0x03];
+  calibration->t0_degc = t0 >> 3; // divide by 8 (as documented)
+  calibration->t1_degc = t1 >> 3;
+
+  calibration->h0_t0_out = _le16(&block[0x06]);
+  calibration->h1_t0_out = _le16(&block[0x0A]);
+  calibration->t0_out = _le16(&block[0x0C]);
+  calibration->t1_out = _le16(&block[0x0E]);
+  calibration->crc = hts221_calibrationCRC(calibration);
+}
+
+/**
+ * @brief Computes the CRC-16/CCITT-FALSE of a calibration, covering every
+ * field before `crc` in order, with the 16-bit fields as little-endian bytes.
+ * That is the same byte sequence a log header stores, and it doesn't depend
+ * on the host's byte order or struct layout.
+ *
+ * @param calibration The calibration to check
+ * @return uint16_t The CRC
+ */
+uint16_t hts221_calibrationCRC(const hts221_calibration_t *calibration) {
+  const uint16_t words[] = {calibration->t0_degc,   calibration->t1_degc,
+                            calibration->t0_out,    calibration->t1_out,
+                            calibration->h0_t0_out, calibration->h1_t0_out};
+  uint8_t data[4 + sizeof(words)];
+  data[0] = calibration->chip_id;
+  data[1] = calibration->h0_rh_x2;
+  data[2] = calibration->h1_rh_x2;
+  data[3] = calibration->reserved;
+  for (uint8_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+    data[4 + 2 * i] = words[i] & 0xFF;
+    data[5 + 2 * i] = words[i] >> 8;
+  }
+
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < sizeof(data); i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief Folds a calibration into the fixed-point slope and offset used for
+ * every conversion so no per-sample division is needed
+ *
+ * Compared to evaluating the calibration line with a float division, the
+ * float results are within 0.01 degrees C / 0.01 %RH over the sensor's range;
+ * the error comes from the slope being held to 1/16384 of a hundredth per
+ * LSB. The centi conversions additionally round to the nearest hundredth.
+ *
+ * @param calibration The sensor's factory calibration
+ * @param coeffs Set to the coefficients. A calibration with a zero span
+ * gives a zero scale rather than dividing by zero
+ */
+void hts221_computeCoeffs(const hts221_calibration_t *calibration,
+                          hts221_coeffs_t *coeffs) {
+  // info from
+  // https://www.st.com/resource/en/datasheet/hts221.pdf
+  // T = T0 + (T_OUT - T0_OUT) * (T1 - T0) / (T1_OUT - T0_OUT)
+  int16_t t0 = (int16_t)calibration->t0_degc;
+  int16_t t0_out = (int16_t)calibration->t0_out;
+  int32_t t0_centi = (int32_t)t0 * 100;
+  int32_t t_delta_centi = ((int32_t)(int16_t)calibration->t1_degc - t0) * 100;
+  int32_t t_out_delta = (int32_t)(int16_t)calibration->t1_out - t0_out;
+
+  // H0 and H1 are stored x2, so x50 gives hundredths of a percent
+  int16_t h0_t0_out = (int16_t)calibration->h0_t0_out;
+  int32_t h0_centi = (int32_t)calibration->h0_rh_x2 * 50;
+  int32_t h_delta_centi =
+      ((int32_t)calibration->h1_rh_x2 - calibration->h0_rh_x2) * 50;
+  int32_t h_out_delta = (int32_t)(int16_t)calibration->h1_t0_out - h0_t0_out;
+
+  // a zero span means bad calibration data; avoid dividing by it
+  coeffs->temp_scale = 0;
+  if (t_out_delta != 0) {
+    coeffs->temp_scale =
+        (t_delta_centi * (1L << HTS221_CAL_SHIFT) + t_out_delta / 2) /
+        t_out_delta;
+  }
+  coeffs->temp_offset = t0_centi * (1L << HTS221_CAL_SHIFT) -
+                        (int32_t)t0_out * coeffs->temp_scale +
+                        (1L << (HTS221_CAL_SHIFT - 1));
+
+  coeffs->humidity_scale = 0;
+  if (h_out_delta != 0) {
+    coeffs->humidity_scale =
+        (h_delta_centi * (1L << HTS221_CAL_SHIFT) + h_out_delta / 2) /
+        h_out_delta;
+  }
+  coeffs->humidity_offset = h0_centi * (1L << HTS221_CAL_SHIFT) -
+                            (int32_t)h0_t0_out * coeffs->humidity_scale +
+                            (1L << (HTS221_CAL_SHIFT - 1));
+}
+
+/**
+ * @brief Converts an array of raw temperature counts to degrees C
+ *
+ * @param coeffs The coefficients for the sensor the counts came from
+ * @param raw The raw TEMP_OUT values
+ * @param temperatures Array of `count` entries for the results; must not
+ * overlap `raw`
+ * @param count The number of values to convert
+ */
+void hts221_convertTemperatures(const hts221_coeffs_t *coeffs,
+                                const int16_t *raw, float *temperatures,
+                                size_t count) {
+  _convertFloat(coeffs->temp_scale, coeffs->temp_offset, raw, temperatures,
+                count);
+}
+
+/**
+ * @brief Converts an array of raw humidity counts to percent RH
+ *
+ * @param coeffs The coefficients for the sensor the counts came from
+ * @param raw The raw HUMIDITY_OUT values
+ * @param humidities Array of `count` entries for the results; must not
+ * overlap `raw`
+ * @param count The number of values to convert
+ */
+void hts221_convertHumidities(const hts221_coeffs_t *coeffs,
+                              const int16_t *raw, float *humidities,
+                              size_t count) {
+  _convertFloat(coeffs->humidity_scale, coeffs->humidity_offset, raw,
+                humidities, count);
+}
+
+/**
+ * @brief Converts an array of raw temperature counts to hundredths of a
+ * degree C
+ *
+ * @param coeffs The coefficients for the sensor the counts came from
+ * @param raw The raw TEMP_OUT values
+ * @param temperatures Array of `count` entries for the results; must not
+ * overlap `raw`
+ * @param count The number of values to convert
+ */
+void hts221_convertTemperaturesCenti(const hts221_coeffs_t *coeffs,
+                                     const int16_t *raw,
+                                     int16_t *temperatures, size_t count) {
+  _convertCenti(coeffs->temp_scale, coeffs->temp_offset, raw, temperatures,
+                count);
+}
+
+/**
+ * @brief Converts an array of raw humidity counts to hundredths of a
+ * percent RH
+ *
+ * @param coeffs The coefficients for the sensor the counts came from
+ * @param raw The raw HUMIDITY_OUT values
+ * @param humidities Array of `count` entries for the results; must not
+ * overlap `raw`
+ * @param count The number of values to convert
+ */
+void hts221_convertHumiditiesCenti(const hts221_coeffs_t *coeffs,
+                                   const int16_t *raw, int16_t *humidities,
+                                   size_t count) {
+  _convertCenti(coeffs->humidity_scale, coeffs->humidity_offset, raw,
+                humidities, count);
+}
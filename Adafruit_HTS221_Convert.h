@@ -0,0 +1,135 @@
+/*!
+ *  @file Adafruit_HTS221_Convert.h
+ *
+ * 	Raw to physical unit conversion for the Adafruit HTS221 Humidity and
+ * 	Temperature Sensor library. Has no Arduino dependencies so stored raw
+ * 	readings can be converted on any host.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_CONVERT_H
+#define _ADAFRUIT_HTS221_CONVERT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HTS221_CHIP_ID 0xBC     ///< HTS221 default device id from WHOAMI
+#define HTS221_CAL_SHIFT 14     ///< Fraction bits of the fixed-point coeffs
+#define HTS221_CAL_BLOCK_LEN 16 ///< Size of the 0x30-0x3F calibration block
+
+/**
+ * @brief The decoded factory calibration of one sensor, as a plain blob that
+ * can be kept in RTC RAM or EEPROM to skip the boot wait and calibration
+ * reads on the next `begin_I2C()` or `begin_SPI()`.
+ */
+typedef struct {
+  uint8_t chip_id;    ///< WHO_AM_I value of the chip the data came from
+  uint8_t h0_rh_x2;   ///< H0_rH_x2 calibration value
+  uint8_t h1_rh_x2;   ///< H1_rH_x2 calibration value
+  uint8_t reserved;   ///< Padding; always zero
+  uint16_t t0_degc;   ///< T0 in degrees C, MSBs applied
+  uint16_t t1_degc;   ///< T1 in degrees C, MSBs applied
+  uint16_t t0_out;    ///< T0_OUT calibration value
+  uint16_t t1_out;    ///< T1_OUT calibration value
+  uint16_t h0_t0_out; ///< H0_T0_OUT calibration value
+  uint16_t h1_t0_out; ///< H1_T0_OUT calibration value
+  uint16_t crc;       ///< CRC-16/CCITT of the fields above, little-endian
+} hts221_calibration_t;
+
+/**
+ * @brief A timestamped raw sample, as captured on a DRDY edge or stored in a
+ * log
+ */
+typedef struct {
+  uint32_t timestamp_us; ///< micros() at the DRDY edge
+  int16_t temperature;   ///< Raw TEMP_OUT value
+  int16_t humidity;      ///< Raw HUMIDITY_OUT value
+} hts221_raw_sample_t;
+
+/**
+ * @brief Fixed-point conversion coefficients, folded from the factory
+ * calibration once when it is loaded.
+ *
+ * A raw count converts to hundredths of a degree C or %RH with one multiply,
+ * one add and one shift: `(raw * scale + offset) >> HTS221_CAL_SHIFT`. The
+ * rounding term is already included in the offset.
+ */
+typedef struct {
+  int32_t temp_scale;      ///< Centi-degrees C per LSB, scaled by the shift
+  int32_t temp_offset;     ///< Centi-degrees C at zero LSB, scaled + rounding
+  int32_t humidity_scale;  ///< Centi-%RH per LSB, scaled by the shift
+  int32_t humidity_offset; ///< Centi-%RH at zero LSB, scaled + rounding
+} hts221_coeffs_t;
+
+/**
+ * @brief Converts a raw temperature count to hundredths of a degree C
+ *
+ * @param coeffs The coefficients for the sensor the count came from
+ * @param raw The raw TEMP_OUT value
+ * @return int16_t The temperature in centi-degrees C
+ */
+static inline int16_t hts221_centiTemperature(const hts221_coeffs_t *coeffs,
+                                              int16_t raw) {
+  return (int16_t)(((int32_t)raw * coeffs->temp_scale + coeffs->temp_offset) >>
+                   HTS221_CAL_SHIFT);
+}
+
+/**
+ * @brief Converts a raw humidity count to hundredths of a percent RH
+ *
+ * @param coeffs The coefficients for the sensor the count came from
+ * @param raw The raw HUMIDITY_OUT value
+ * @return int16_t The relative humidity in centi-%RH
+ */
+static inline int16_t hts221_centiHumidity(const hts221_coeffs_t *coeffs,
+                                           int16_t raw) {
+  return (int16_t)(((int32_t)raw * coeffs->humidity_scale +
+                    coeffs->humidity_offset) >>
+                   HTS221_CAL_SHIFT);
+}
+
+/**
+ * @brief Converts a raw count to degrees C or percent RH. The integer
+ * multiply-add is done first and then scaled once, so unlike the centi
+ * conversions the result keeps the fractions of a hundredth
+ *
+ * @param scale The channel's `temp_scale` or `humidity_scale` coefficient
+ * @param offset The channel's `temp_offset` or `humidity_offset` coefficient
+ * @param raw The raw TEMP_OUT or HUMIDITY_OUT value
+ * @return float The reading in degrees C or percent RH
+ */
+static inline float hts221_rawToFloat(int32_t scale, int32_t offset,
+                                      int16_t raw) {
+  // the offset's rounding term is for the shift, so it comes back out here.
+  // Kept to 32 bits so bulk loops over this still vectorize
+  int32_t unrounded = offset - (int32_t)(1L << (HTS221_CAL_SHIFT - 1));
+  return (float)((int32_t)raw * scale + unrounded) *
+         (1.0f / (100.0f * (1L << HTS221_CAL_SHIFT)));
+}
+
+void hts221_parseCalibration(const uint8_t *block,
+                             hts221_calibration_t *calibration);
+uint16_t hts221_calibrationCRC(const hts221_calibration_t *calibration);
+void hts221_computeCoeffs(const hts221_calibration_t *calibration,
+                          hts221_coeffs_t *coeffs);
+
+void hts221_convertTemperatures(const hts221_coeffs_t *coeffs,
+                                const int16_t *raw, float *temperatures,
+                                size_t count);
+void hts221_convertHumidities(const hts221_coeffs_t *coeffs,
+                              const int16_t *raw, float *humidities,
+                              size_t count);
+void hts221_convertTemperaturesCenti(const hts221_coeffs_t *coeffs,
+                                     const int16_t *raw,
+                                     int16_t *temperatures, size_t count);
+void hts221_convertHumiditiesCenti(const hts221_coeffs_t *coeffs,
+                                   const int16_t *raw, int16_t *humidities,
+                                   size_t count);
+
+#endif
@@ -0,0 +1,132 @@
+/*!
+ *  @file Adafruit_HTS221_Filter.cpp
+ *
+ * 	Fixed-memory smoothing and decimation of raw samples for the Adafruit
+ * 	HTS221 Humidity and Temperature Sensor library
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_HTS221_Filter.h"
+
+// moves an average with 8 fraction bits 1/2^shift of the way to a sample.
+// The step is rounded half away from zero: a plain shift rounds down, which
+// leaves the average up to 2^shift - 1 short of a rising input for good
+static int32_t _emaStep(int32_t average, int16_t sample, uint8_t shift) {
+  int32_t diff = (int32_t)sample * 256 - average;
+  int32_t half = (int32_t)1 << (shift - 1);
+  if (diff < 0) {
+    return average - ((half - diff) >> shift);
+  }
+  return average + ((diff + half) >> shift);
+}
+
+/*!
+ *    @brief  Creates a filter. With the defaults every stage is off and
+ *            samples pass through unchanged
+ *    @param  median_window The number of samples to take the median of, up
+ *            to HTS221_FILTER_MAX_MEDIAN; 3 removes any single-sample spike
+ *    @param  ema_shift Smoothing of the moving average, up to
+ *            HTS221_FILTER_MAX_SHIFT. Each sample moves the average 1/2^shift
+ *            of the way to it, so the time constant is about 2^shift samples
+ *    @param  decimation Pass on one sample in this many. Smoothing over about
+ *            as many samples as are dropped avoids aliasing
+ */
+Adafruit_HTS221_Filter::Adafruit_HTS221_Filter(uint8_t median_window,
+                                               uint8_t ema_shift,
+                                               uint8_t decimation) {
+  if (median_window < 1) {
+    median_window = 1;
+  }
+  _median_window = median_window < HTS221_FILTER_MAX_MEDIAN
+                       ? median_window
+                       : HTS221_FILTER_MAX_MEDIAN;
+  _ema_shift = ema_shift < HTS221_FILTER_MAX_SHIFT ? ema_shift
+                                                   : HTS221_FILTER_MAX_SHIFT;
+  _decimation = decimation ? decimation : 1;
+  reset();
+}
+
+/*!
+ *    @brief  Forgets all past samples, for example after a gap in the data
+ */
+void Adafruit_HTS221_Filter::reset(void) {
+  _median_count = 0;
+  _median_next = 0;
+  _ema_temp = 0;
+  _ema_humid = 0;
+  _ema_started = false;
+  // pass on the first sample so a reading is available straight away
+  _skipped = _decimation - 1;
+}
+
+/*!
+ *    @brief  Runs one sample through the filter
+ *    @param  sample The next raw sample. When this returns true it is
+ *            replaced with the filtered sample; the timestamp is kept
+ *    @return True if a filtered sample was produced, false if this sample
+ *            was absorbed by the decimation
+ */
+bool Adafruit_HTS221_Filter::process(hts221_raw_sample_t *sample) {
+  int16_t temperature = sample->temperature;
+  int16_t humidity = sample->humidity;
+
+  if (_median_window > 1) {
+    _median_temp[_median_next] = temperature;
+    _median_humid[_median_next] = humidity;
+    if (++_median_next >= _median_window) {
+      _median_next = 0;
+    }
+    if (_median_count < _median_window) {
+      _median_count++;
+    }
+    temperature = _median(_median_temp);
+    humidity = _median(_median_humid);
+  }
+
+  if (_ema_shift) {
+    // the averages carry 8 fraction bits so small steps aren't lost
+    if (!_ema_started) {
+      _ema_temp = (int32_t)temperature * 256;
+      _ema_humid = (int32_t)humidity * 256;
+      _ema_started = true;
+    } else {
+      _ema_temp = _emaStep(_ema_temp, temperature, _ema_shift);
+      _ema_humid = _emaStep(_ema_humid, humidity, _ema_shift);
+    }
+    temperature = (int16_t)((_ema_temp + 128) >> 8);
+    humidity = (int16_t)((_ema_humid + 128) >> 8);
+  }
+
+  if (++_skipped < _decimation) {
+    return false;
+  }
+  _skipped = 0;
+  sample->temperature = temperature;
+  sample->humidity = humidity;
+  return true;
+}
+
+/*!
+ *    @brief  Finds the median of the filled part of a history
+ *    @param  history The history to take the median of
+ *    @return The middle value; the upper middle one for an even count
+ */
+int16_t Adafruit_HTS221_Filter::_median(const int16_t *history) {
+  // insertion sort of a copy; there are at most 5 values
+  int16_t sorted[HTS221_FILTER_MAX_MEDIAN];
+  for (uint8_t i = 0; i < _median_count; i++) {
+    int16_t value = history[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  return sorted[_median_count / 2];
+}
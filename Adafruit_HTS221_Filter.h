@@ -0,0 +1,61 @@
+/*!
+ *  @file Adafruit_HTS221_Filter.h
+ *
+ * 	Fixed-memory smoothing and decimation of raw samples for the Adafruit
+ * 	HTS221 Humidity and Temperature Sensor library. Works on the raw counts
+ * 	with integer math only, so only the samples that come out the end need
+ * 	converting. Has no Arduino dependencies so logged samples can be filtered
+ * 	the same way on a host.
+ *
+ * 	Each sample goes through three optional stages in turn:
+ * 	  - a median over the last few samples, to reject single-sample spikes
+ * 	  - an exponential moving average, weighting each new sample 1/2^shift
+ * 	  - N:1 decimation, passing on every Nth smoothed sample
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_FILTER_H
+#define _ADAFRUIT_HTS221_FILTER_H
+
+#include "Adafruit_HTS221_Convert.h"
+
+#define HTS221_FILTER_MAX_MEDIAN 5 ///< Widest median window
+#define HTS221_FILTER_MAX_SHIFT 8  ///< Heaviest EMA smoothing
+
+/*!
+ *    @brief  A median, EMA and decimation filter on raw samples. Attach one
+ *            to a sensor with `Adafruit_HTS221::setFilter()`, or call
+ *            `process()` directly on stored samples
+ */
+class Adafruit_HTS221_Filter {
+public:
+  Adafruit_HTS221_Filter(uint8_t median_window = 1, uint8_t ema_shift = 0,
+                         uint8_t decimation = 1);
+
+  void reset(void);
+  bool process(hts221_raw_sample_t *sample);
+
+private:
+  uint8_t _median_window; ///< Samples in the median, 1 to turn it off
+  uint8_t _ema_shift;     ///< EMA weight as a shift, 0 to turn it off
+  uint8_t _decimation;    ///< Samples in per sample out
+
+  int16_t _median_temp[HTS221_FILTER_MAX_MEDIAN];  ///< Recent temperatures
+  int16_t _median_humid[HTS221_FILTER_MAX_MEDIAN]; ///< Recent humidities
+  uint8_t _median_count; ///< Valid entries in the median histories
+  uint8_t _median_next;  ///< Next history slot to overwrite
+  int32_t _ema_temp;     ///< Temperature average, in 1/256ths of a count
+  int32_t _ema_humid;    ///< Humidity average, in 1/256ths of a count
+  bool _ema_started;     ///< The averages hold a sample
+  uint8_t _skipped;      ///< Samples dropped since the last one passed on
+
+  int16_t _median(const int16_t *history);
+};
+
+#endif
@@ -0,0 +1,243 @@
+/*!
+ *  @file Adafruit_HTS221_Governor.cpp
+ *
+ * 	Adaptive output data rate for the Adafruit HTS221 Humidity and Temperature
+ * 	Sensor library. At one shot the sensor idles between conversions, so
+ * 	both its supply current and the time spent polling it drop to a fraction
+ * 	of what continuous 12.5 Hz costs.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_HTS221_Governor.h"
+
+// the size of a change as a rate per second
+static uint32_t _perSecond(int16_t from, int16_t to, uint32_t span_ms) {
+  int32_t change = (int32_t)to - from;
+  return (uint32_t)(change < 0 ? -change : change) * 1000 / span_ms;
+}
+
+/*!
+ *    @brief  Instantiates a governor for a sensor
+ *    @param  sensor The sensor; it must already be initialized
+ */
+Adafruit_HTS221_Governor::Adafruit_HTS221_Governor(Adafruit_HTS221 *sensor)
+    : _sensor(sensor), _data_rate(HTS221_RATE_12_5_HZ) {}
+
+/*!
+ *    @brief  Starts governing, at a given data rate
+ *    @param  data_rate The rate to start at
+ */
+void Adafruit_HTS221_Governor::begin(hts221_rate_t data_rate) {
+  _transitions = 0;
+  _have_sample = false;
+  _oneshot_waiting = false;
+  _data_rate = data_rate;
+  _sensor->setDataRate(data_rate);
+}
+
+/*!
+ *    @brief  Reads the sensor if a new sample is due and adjusts the data
+ *            rate. Call regularly from the main loop; it never waits, and
+ *            between samples it does no bus traffic
+ *    @param  temperature Set to the temperature in hundredths of a degree C
+ *            when there is a new sample
+ *    @param  humidity Set to the relative humidity in hundredths of a
+ *            percent when there is a new sample
+ *    @return True if there was a new sample
+ */
+bool Adafruit_HTS221_Governor::update(int16_t *temperature,
+                                      int16_t *humidity) {
+  if (!_readSample(temperature, humidity)) {
+    return false;
+  }
+  _last_ms = millis();
+  _evaluate(*temperature, *humidity, _last_ms);
+  return true;
+}
+
+/*!
+ *    @brief  Sets how fast readings have to change to speed the sensor up.
+ *            It slows down again once they change at under half of this
+ *    @param  temp_rate Temperature change in hundredths of a degree C per
+ *            second; the default is 10
+ *    @param  humidity_rate Humidity change in hundredths of a percent RH per
+ *            second; the default is 50
+ */
+void Adafruit_HTS221_Governor::setThresholds(uint16_t temp_rate,
+                                             uint16_t humidity_rate) {
+  _temp_rate = temp_rate;
+  _humid_rate = humidity_rate;
+}
+
+/*!
+ *    @brief  Sets how long readings have to stay steady before the sensor is
+ *            slowed down a step
+ *    @param  hold_ms The hold time in milliseconds; the default is 30000
+ */
+void Adafruit_HTS221_Governor::setHoldTime(uint32_t hold_ms) {
+  _hold_ms = hold_ms;
+}
+
+/*!
+ *    @brief  Sets the time between conversions at the slowest, one shot,
+ *            level
+ *    @param  interval_ms The interval in milliseconds; the default is 10000
+ */
+void Adafruit_HTS221_Governor::setOneShotInterval(uint32_t interval_ms) {
+  _interval_ms = interval_ms;
+}
+
+/*!
+ *    @brief  Sets a function to call on each data rate change
+ *    @param  callback The function, or NULL for none
+ */
+void Adafruit_HTS221_Governor::onTransition(hts221_rate_callback_t callback) {
+  _callback = callback;
+}
+
+/*!
+ *    @brief  Gets the data rate the sensor is running at
+ *    @return The current data rate
+ */
+hts221_rate_t Adafruit_HTS221_Governor::getDataRate(void) {
+  return _data_rate;
+}
+
+/*!
+ *    @brief  Gets the number of data rate changes
+ *    @return The number of transitions since `begin()`
+ */
+uint32_t Adafruit_HTS221_Governor::getTransitions(void) {
+  return _transitions;
+}
+
+/*!
+ *    @brief  Gets a new sample if one is due, without waiting
+ *    @param  temperature Set to the temperature in hundredths of a degree C
+ *    @param  humidity Set to the relative humidity in hundredths of a percent
+ *    @return True if there was a new sample
+ */
+bool Adafruit_HTS221_Governor::_readSample(int16_t *temperature,
+                                           int16_t *humidity) {
+  uint32_t since_ms = millis() - _last_ms;
+
+  if (_data_rate == HTS221_RATE_ONE_SHOT) {
+    if (!_oneshot_waiting) {
+      if (_have_sample && since_ms < _interval_ms) {
+        return false;
+      }
+      _oneshot_waiting = _sensor->startOneShot();
+      return false;
+    }
+    if (!_sensor->pollOneShot()) {
+      return false;
+    }
+    _oneshot_waiting = false;
+  } else if (_have_sample && since_ms < _periodMs(_data_rate)) {
+    // no new sample can be ready within a period of the last one
+    return false;
+  }
+
+  // readCenti() rather than readBatch(), which would drain a DRDY capture
+  // queue the sketch may be running; a sample read here is queued there
+  // too. After pollOneShot() the result is already loaded, so then this
+  // doesn't touch the bus
+  if (!_sensor->readCenti(temperature, humidity)) {
+    return false;
+  }
+  // the sensor may not have converted anything since the last sample
+  uint32_t sample_us = _sensor->getSampleTime();
+  if (_have_sample && sample_us == _sample_us) {
+    return false;
+  }
+  _sample_us = sample_us;
+  return true;
+}
+
+/*!
+ *    @brief  Measures how fast the readings are changing and steps the data
+ *            rate up or down
+ *    @param  temperature The new temperature in hundredths of a degree C
+ *    @param  humidity The new humidity in hundredths of a percent RH
+ *    @param  now_ms millis() at the new sample
+ */
+void Adafruit_HTS221_Governor::_evaluate(int16_t temperature,
+                                         int16_t humidity, uint32_t now_ms) {
+  if (!_have_sample) {
+    _have_sample = true;
+    _anchor_ms = now_ms;
+    _anchor_temp = temperature;
+    _anchor_humid = humidity;
+    _calm_ms = now_ms;
+    return;
+  }
+
+  // changes are measured from an anchor sample at least a window back, so
+  // sample to sample noise at the fast rates doesn't read as a trend. A fast
+  // step still shows up on the first sample after it
+  uint32_t elapsed_ms = now_ms - _anchor_ms;
+  uint32_t span_ms = elapsed_ms > HTS221_GOVERNOR_WINDOW_MS
+                         ? elapsed_ms
+                         : HTS221_GOVERNOR_WINDOW_MS;
+  uint32_t temp_rate = _perSecond(_anchor_temp, temperature, span_ms);
+  uint32_t humid_rate = _perSecond(_anchor_humid, humidity, span_ms);
+
+  bool fast = temp_rate > _temp_rate || humid_rate > _humid_rate;
+  bool calm = temp_rate * 2 < _temp_rate && humid_rate * 2 < _humid_rate;
+  if (fast || elapsed_ms >= HTS221_GOVERNOR_WINDOW_MS) {
+    _anchor_ms = now_ms;
+    _anchor_temp = temperature;
+    _anchor_humid = humidity;
+  }
+
+  if (fast) {
+    _calm_ms = now_ms;
+    if (_data_rate != HTS221_RATE_12_5_HZ) {
+      _setDataRate((hts221_rate_t)(_data_rate + 1));
+    }
+  } else if (!calm) {
+    _calm_ms = now_ms;
+  } else if (now_ms - _calm_ms >= _hold_ms &&
+             _data_rate != HTS221_RATE_ONE_SHOT) {
+    _calm_ms = now_ms;
+    _setDataRate((hts221_rate_t)(_data_rate - 1));
+  }
+}
+
+/*!
+ *    @brief  Switches the sensor to a new data rate and reports it
+ *    @param  data_rate The new rate
+ */
+void Adafruit_HTS221_Governor::_setDataRate(hts221_rate_t data_rate) {
+  hts221_rate_t from = _data_rate;
+  _sensor->setDataRate(data_rate);
+  _data_rate = data_rate;
+  _oneshot_waiting = false;
+  _transitions++;
+  if (_callback) {
+    _callback(from, data_rate);
+  }
+}
+
+/*!
+ *    @brief  Gets the time between samples for a continuous data rate
+ *    @param  data_rate The data rate
+ *    @return The output period in milliseconds, rounded down
+ */
+uint16_t Adafruit_HTS221_Governor::_periodMs(hts221_rate_t data_rate) {
+  switch (data_rate) {
+  case HTS221_RATE_1_HZ:
+    return 1000;
+  case HTS221_RATE_7_HZ:
+    return 142;
+  case HTS221_RATE_12_5_HZ:
+    return 80;
+  default:
+    return 0;
+  }
+}
@@ -0,0 +1,74 @@
+/*!
+ *  @file Adafruit_HTS221_Governor.h
+ *
+ * 	Adaptive output data rate for the Adafruit HTS221 Humidity and Temperature
+ * 	Sensor library. Slows the sensor down while readings are steady and
+ * 	speeds it back up as soon as they start to change.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_GOVERNOR_H
+#define _ADAFRUIT_HTS221_GOVERNOR_H
+
+#include "Adafruit_HTS221.h"
+
+#define HTS221_GOVERNOR_WINDOW_MS 1000 ///< Shortest span a rate is taken over
+
+/** Called by the governor each time it changes the data rate */
+typedef void (*hts221_rate_callback_t)(hts221_rate_t from, hts221_rate_t to);
+
+/*!
+ *    @brief  Drives a sensor's data rate from how fast its readings change.
+ *            The rate steps up one level (one shot, 1 Hz, 7 Hz, 12.5 Hz) on
+ *            any sample that changes faster than the thresholds, and steps
+ *            down one level once changes have stayed under half the
+ *            thresholds for the hold time
+ */
+class Adafruit_HTS221_Governor {
+public:
+  Adafruit_HTS221_Governor(Adafruit_HTS221 *sensor);
+
+  void begin(hts221_rate_t data_rate = HTS221_RATE_12_5_HZ);
+  bool update(int16_t *temperature, int16_t *humidity);
+
+  void setThresholds(uint16_t temp_rate, uint16_t humidity_rate);
+  void setHoldTime(uint32_t hold_ms);
+  void setOneShotInterval(uint32_t interval_ms);
+  void onTransition(hts221_rate_callback_t callback);
+
+  hts221_rate_t getDataRate(void);
+  uint32_t getTransitions(void);
+
+private:
+  bool _readSample(int16_t *temperature, int16_t *humidity);
+  void _evaluate(int16_t temperature, int16_t humidity, uint32_t now_ms);
+  void _setDataRate(hts221_rate_t data_rate);
+  static uint16_t _periodMs(hts221_rate_t data_rate);
+
+  Adafruit_HTS221 *_sensor;                ///< The governed sensor
+  hts221_rate_callback_t _callback = NULL; ///< Told about each rate change
+
+  hts221_rate_t _data_rate;      ///< Current data rate
+  uint16_t _temp_rate = 10;      ///< Step up threshold, centi-degrees C/s
+  uint16_t _humid_rate = 50;     ///< Step up threshold, centi-%RH/s
+  uint32_t _hold_ms = 30000;     ///< Calm time before stepping down
+  uint32_t _interval_ms = 10000; ///< Time between one shots
+  uint32_t _transitions = 0;     ///< Rate changes since `begin()`
+
+  bool _oneshot_waiting = false; ///< A one shot has been started
+  bool _have_sample = false;     ///< `_last_ms` and the anchor are valid
+  uint32_t _last_ms = 0;         ///< millis() at the last sample
+  uint32_t _sample_us = 0;       ///< Sensor's time of the last sample
+  uint32_t _anchor_ms = 0;       ///< millis() at the anchor sample
+  int16_t _anchor_temp = 0;      ///< Temperature changes are measured from
+  int16_t _anchor_humid = 0;     ///< Humidity changes are measured from
+  uint32_t _calm_ms = 0;         ///< millis() since when changes were small
+};
+
+#endif
@@ -0,0 +1,260 @@
+/*!
+ *  @file Adafruit_HTS221_Group.cpp
+ *
+ * 	Reads a group of HTS221 sensors spread over several I2C buses and
+ * 	TCA9548A mux channels as one timestamped snapshot. The HTS221 has a fixed
+ * 	address, so larger installations need one bus or mux channel per sensor.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_HTS221_Group.h"
+
+/*!
+ *    @brief  Instantiates an empty group that keeps its sensors and results
+ *            in caller provided storage, sized for the application
+ *    @param  members Array the group keeps its sensors in
+ *    @param  readings Array the group keeps its results in
+ *    @param  capacity The number of entries in each array
+ */
+Adafruit_HTS221_Group::Adafruit_HTS221_Group(hts221_group_member_t *members,
+                                             hts221_group_reading_t *readings,
+                                             uint8_t capacity) {
+  _members = members;
+  _readings = readings;
+  _capacity = capacity;
+}
+
+/*!
+ *    @brief  Adds a sensor to the group. Call before `begin()`
+ *    @param  sensor The sensor; it is initialized by `begin()`
+ *    @param  wire The I2C bus the sensor, or its mux, is on
+ *    @param  mux_address The TCA9548A's I2C address, or HTS221_NO_MUX if the
+ *            sensor is directly on the bus
+ *    @param  mux_channel The mux channel (0-7) the sensor is on
+ *    @return True if there was room for the sensor. False also if another
+ *            sensor is already at 0x5F on the same bus, mux and channel, or
+ *            on the same bus with no mux, as the two would collide. A sensor
+ *            directly on a bus can't share it with muxed ones either, since
+ *            it would answer alongside every channel
+ */
+bool Adafruit_HTS221_Group::add(Adafruit_HTS221 *sensor, TwoWire *wire,
+                                uint8_t mux_address, uint8_t mux_channel) {
+  if (_count == _capacity) {
+    return false;
+  }
+  for (uint8_t i = 0; i < _count; i++) {
+    const hts221_group_member_t *other = &_members[i];
+    if (other->wire != wire) {
+      continue;
+    }
+    // a sensor directly on the bus answers whichever channel is switched in
+    bool direct = (mux_address == HTS221_NO_MUX);
+    if (direct != (other->mux_address == HTS221_NO_MUX) ||
+        (other->mux_address == mux_address &&
+         (direct || other->mux_channel == mux_channel))) {
+      return false;
+    }
+  }
+
+  // find or add the bus
+  uint8_t bus = 0;
+  while (bus < _bus_count && _buses[bus].wire != wire) {
+    bus++;
+  }
+  if (bus == _bus_count) {
+    if (_bus_count == HTS221_GROUP_MAX_BUSES) {
+      return false;
+    }
+    _buses[bus].wire = wire;
+    _buses[bus].mux_address = HTS221_NO_MUX;
+    _buses[bus].mux_channel = 0;
+    _bus_count++;
+  }
+
+  hts221_group_member_t member;
+  member.sensor = sensor;
+  member.wire = wire;
+  member.mux_address = mux_address;
+  member.mux_channel = mux_channel;
+  member.index = _count;
+  member.triggered = false;
+
+  // keep the members sorted by bus, then mux, then channel so a read
+  // visits each channel once and switches as little as possible
+  uint8_t i = _count;
+  while (i > 0) {
+    const hts221_group_member_t *prev = &_members[i - 1];
+    uint8_t prev_bus = 0;
+    while (_buses[prev_bus].wire != prev->wire) {
+      prev_bus++;
+    }
+    if (prev_bus < bus ||
+        (prev_bus == bus && (prev->mux_address < mux_address ||
+                             (prev->mux_address == mux_address &&
+                              prev->mux_channel <= mux_channel)))) {
+      break;
+    }
+    _members[i] = *prev;
+    i--;
+  }
+  _members[i] = member;
+  _count++;
+  return true;
+}
+
+/*!
+ *    @brief  Initializes every sensor in the group
+ *    @return True if all of the sensors were found and initialized
+ */
+bool Adafruit_HTS221_Group::begin(void) {
+  bool ok = true;
+
+  // channels left enabled from before a reset would put several sensors on
+  // the bus at 0x5F, so turn every mux off before talking to any of them
+  for (uint8_t i = 0; i < _count; i++) {
+    hts221_group_member_t *member = &_members[i];
+    if (member->mux_address == HTS221_NO_MUX ||
+        (i > 0 && member->wire == _members[i - 1].wire &&
+         member->mux_address == _members[i - 1].mux_address)) {
+      continue; // no mux, or one already turned off
+    }
+    Adafruit_I2CDevice mux(member->mux_address, member->wire);
+    uint8_t channel_mask = 0;
+    // make sure the bus is running before the first mux write
+    if (!mux.begin(false) || !mux.write(&channel_mask, 1)) {
+      ok = false;
+    }
+  }
+  for (uint8_t i = 0; i < _bus_count; i++) {
+    _buses[i].mux_address = HTS221_NO_MUX;
+  }
+  if (!ok) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < _count; i++) {
+    hts221_group_member_t *member = &_members[i];
+    if (!_select(member) ||
+        !member->sensor->begin_I2C(HTS221_I2CADDR_DEFAULT, member->wire)) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+/*!
+ *    @brief  Sets the longest time to wait for one sensor's conversion
+ *    @param  timeout_ms The timeout in milliseconds
+ */
+void Adafruit_HTS221_Group::setTimeout(uint16_t timeout_ms) {
+  _timeout_ms = timeout_ms;
+}
+
+/*!
+ *    @brief  Gets the number of sensors in the group
+ *    @return The number of sensors added
+ */
+uint8_t Adafruit_HTS221_Group::count(void) { return _count; }
+
+/*!
+ *    @brief  Reads every sensor once. All of the one shot conversions are
+ *            started first, then collected in the same order, so the sensors
+ *            convert in parallel and each mux channel is visited twice at
+ *            most
+ *    @param  snapshot Filled with the results, in the order the sensors were
+ *            added, plus the time the cycle took. The results themselves
+ *            stay in the readings array given to the constructor
+ *    @return True if every sensor returned a new sample
+ */
+bool Adafruit_HTS221_Group::read(hts221_group_snapshot_t *snapshot) {
+  uint32_t start_us = micros();
+  bool ok = true;
+  _mux_switches = 0;
+
+  for (uint8_t i = 0; i < _count; i++) {
+    _readings[i].valid = false;
+  }
+
+  // a sensor whose trigger failed still holds its last sample, so it must
+  // not be polled or it would be reported again as new
+  for (uint8_t i = 0; i < _count; i++) {
+    hts221_group_member_t *member = &_members[i];
+    member->triggered = _select(member) && member->sensor->startOneShot();
+  }
+
+  for (uint8_t i = 0; i < _count; i++) {
+    hts221_group_member_t *member = &_members[i];
+    hts221_group_reading_t *reading = &_readings[member->index];
+    if (!member->triggered || !_select(member)) {
+      ok = false;
+      continue;
+    }
+
+    // by now most of the conversions have had time to finish
+    uint32_t wait_start = millis();
+    bool ready;
+    while (!(ready = member->sensor->pollOneShot()) &&
+           (millis() - wait_start) < _timeout_ms) {
+      yield();
+    }
+    if (!ready ||
+        !member->sensor->readCenti(&reading->temperature, &reading->humidity)) {
+      ok = false;
+      continue;
+    }
+    reading->valid = true;
+  }
+
+  snapshot->count = _count;
+  snapshot->readings = _readings;
+  snapshot->mux_switches = _mux_switches;
+  snapshot->latency_us = micros() - start_us;
+  snapshot->timestamp = millis();
+  return ok;
+}
+
+/*!
+ *    @brief  Enables the mux channel a sensor is on, if it isn't already.
+ *            Any other mux on the same bus is turned off first so only one
+ *            HTS221 answers at 0x5F
+ *    @param  member The sensor to select
+ *    @return True if the mux writes succeeded
+ */
+bool Adafruit_HTS221_Group::_select(const hts221_group_member_t *member) {
+  bus_state_t *bus = _buses;
+  while (bus->wire != member->wire) {
+    bus++;
+  }
+  if (bus->mux_address == member->mux_address &&
+      (bus->mux_address == HTS221_NO_MUX ||
+       bus->mux_channel == member->mux_channel)) {
+    return true;
+  }
+
+  uint8_t channel_mask = 0;
+  if (bus->mux_address != HTS221_NO_MUX &&
+      bus->mux_address != member->mux_address) {
+    Adafruit_I2CDevice old_mux(bus->mux_address, bus->wire);
+    if (!old_mux.write(&channel_mask, 1)) {
+      return false;
+    }
+    bus->mux_address = HTS221_NO_MUX;
+  }
+
+  if (member->mux_address != HTS221_NO_MUX) {
+    Adafruit_I2CDevice mux(member->mux_address, member->wire);
+    channel_mask = 1 << member->mux_channel;
+    if (!mux.write(&channel_mask, 1)) {
+      return false;
+    }
+    _mux_switches++;
+  }
+  bus->mux_address = member->mux_address;
+  bus->mux_channel = member->mux_channel;
+  return true;
+}
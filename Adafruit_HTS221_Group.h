@@ -0,0 +1,95 @@
+/*!
+ *  @file Adafruit_HTS221_Group.h
+ *
+ * 	Reads a group of HTS221 sensors spread over several I2C buses and
+ * 	TCA9548A mux channels as one timestamped snapshot
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_GROUP_H
+#define _ADAFRUIT_HTS221_GROUP_H
+
+#include "Adafruit_HTS221.h"
+
+#define HTS221_GROUP_MAX_BUSES 4 ///< Most I2C buses a group can span
+#define HTS221_NO_MUX 0xFF       ///< Mux address for a sensor with no mux
+
+/**
+ * @brief One sensor's result from a group read
+ */
+typedef struct {
+  int16_t temperature; ///< Temperature in hundredths of a degree C
+  int16_t humidity;    ///< Relative humidity in hundredths of a percent
+  bool valid;          ///< The sensor responded with a new sample
+} hts221_group_reading_t;
+
+/**
+ * @brief Where one sensor of a group is attached. The caller provides an
+ * array of these to the group, which fills them in from `add()`
+ */
+typedef struct {
+  Adafruit_HTS221 *sensor; ///< The sensor
+  TwoWire *wire;           ///< The bus the sensor (or its mux) is on
+  uint8_t mux_address;     ///< The mux's address, or HTS221_NO_MUX
+  uint8_t mux_channel;     ///< The mux channel the sensor is on
+  uint8_t index;           ///< Position in the order sensors were added
+  bool triggered;          ///< Its one shot was started in this read
+} hts221_group_member_t;
+
+/**
+ * @brief The results of reading every sensor in a group once
+ */
+typedef struct {
+  uint32_t timestamp;   ///< millis() when the read finished
+  uint32_t latency_us;  ///< Time from starting the conversions to the end
+  uint8_t mux_switches; ///< Number of mux channel changes during the read
+  uint8_t count;        ///< Number of entries in `readings`
+  /** Results in the order added, kept in the group's storage until the
+   * next read */
+  const hts221_group_reading_t *readings;
+} hts221_group_snapshot_t;
+
+/*!
+ *    @brief  Owns a set of HTS221 sensors and reads them all in one cycle,
+ *            ordering the bus traffic by bus and mux channel and overlapping
+ *            the sensors' one shot conversions
+ */
+class Adafruit_HTS221_Group {
+public:
+  Adafruit_HTS221_Group(hts221_group_member_t *members,
+                        hts221_group_reading_t *readings, uint8_t capacity);
+
+  bool add(Adafruit_HTS221 *sensor, TwoWire *wire = &Wire,
+           uint8_t mux_address = HTS221_NO_MUX, uint8_t mux_channel = 0);
+  bool begin(void);
+  bool read(hts221_group_snapshot_t *snapshot);
+  void setTimeout(uint16_t timeout_ms);
+  uint8_t count(void);
+
+private:
+  /** The mux channel currently enabled on a bus */
+  typedef struct {
+    TwoWire *wire;       ///< The bus
+    uint8_t mux_address; ///< The mux with a channel enabled, or HTS221_NO_MUX
+    uint8_t mux_channel; ///< The enabled channel
+  } bus_state_t;
+
+  bool _select(const hts221_group_member_t *member);
+
+  hts221_group_member_t *_members;            ///< Sorted by bus and channel
+  hts221_group_reading_t *_readings;          ///< Results of the last read
+  uint8_t _capacity;                          ///< Entries in both arrays
+  uint8_t _count = 0;                         ///< Number of members
+  bus_state_t _buses[HTS221_GROUP_MAX_BUSES]; ///< Mux state of each bus
+  uint8_t _bus_count = 0;                     ///< Number of buses in use
+  uint8_t _mux_switches = 0;  ///< Mux changes in the current read
+  uint16_t _timeout_ms = 100; ///< Longest wait for one conversion
+};
+
+#endif
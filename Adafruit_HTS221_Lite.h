@@ -0,0 +1,278 @@
+/*!
+ *  @file Adafruit_HTS221_Lite.h
+ *
+ * 	A reduced, compile-time specialized driver for the Adafruit HTS221
+ * 	Humidity and Temperature Sensor library, for boards with little flash.
+ *
+ * 	The bus, address or chip select pin and register auto-increment bit are
+ * 	template parameters, so register accesses compile down to direct Wire or
+ * 	SPI calls with no runtime bus selection, no virtual calls and no heap.
+ * 	Readings are raw counts or fixed-point hundredths only; no floats.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_LITE_H
+#define _ADAFRUIT_HTS221_LITE_H
+
+#include "Adafruit_HTS221.h"
+#include <SPI.h>
+#include <Wire.h>
+
+/**
+ * @brief I2C transport for Adafruit_HTS221_Lite, fixed to one address
+ *
+ * @tparam ADDRESS The 7-bit I2C address of the sensor
+ */
+template <uint8_t ADDRESS = HTS221_I2CADDR_DEFAULT>
+class Adafruit_HTS221_LiteI2C {
+public:
+  static const uint8_t AUTO_INCREMENT = 0x80; ///< Multi-byte address bit
+
+  /**
+   * @brief Creates the transport
+   *
+   * @param wire The Wire object to use
+   */
+  Adafruit_HTS221_LiteI2C(TwoWire *wire = &Wire) : _wire(wire) {}
+
+  /**
+   * @brief Starts the Wire bus
+   *
+   * @return true
+   */
+  bool begin(void) {
+    _wire->begin();
+    return true;
+  }
+
+  /**
+   * @brief Reads consecutive registers with a repeated start
+   *
+   * @param reg The first register, including any auto-increment bit
+   * @param buffer Where to put the register values
+   * @param len The number of registers to read
+   * @return true if the sensor acknowledged and returned every byte
+   */
+  bool read(uint8_t reg, uint8_t *buffer, uint8_t len) {
+    _wire->beginTransmission(ADDRESS);
+    _wire->write(reg);
+    if (_wire->endTransmission(false) != 0) {
+      return false;
+    }
+    if (_wire->requestFrom((uint8_t)ADDRESS, len, (uint8_t) true) != len) {
+      return false;
+    }
+    for (uint8_t i = 0; i < len; i++) {
+      buffer[i] = _wire->read();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Writes consecutive registers
+   *
+   * @param reg The first register, including any auto-increment bit
+   * @param buffer The register values
+   * @param len The number of registers to write
+   * @return true if the sensor acknowledged the write
+   */
+  bool write(uint8_t reg, const uint8_t *buffer, uint8_t len) {
+    _wire->beginTransmission(ADDRESS);
+    _wire->write(reg);
+    _wire->write(buffer, len);
+    return _wire->endTransmission() == 0;
+  }
+
+private:
+  TwoWire *_wire;
+};
+
+/**
+ * @brief Hardware SPI transport for Adafruit_HTS221_Lite, fixed to one chip
+ * select pin. Wired as for `Adafruit_HTS221::begin_SPI()`, with MOSI and MISO
+ * both on the sensor's 3-wire SDI/SDO pin.
+ *
+ * @tparam CS_PIN The chip select pin
+ * @tparam FREQUENCY The SPI clock in Hz
+ */
+template <uint8_t CS_PIN, uint32_t FREQUENCY = HTS221_SPI_DEFAULT_FREQ>
+class Adafruit_HTS221_LiteSPI {
+  static_assert(FREQUENCY <= HTS221_SPI_MAX_FREQ,
+                "The HTS221 SPI clock is limited to HTS221_SPI_MAX_FREQ");
+
+public:
+  static const uint8_t AUTO_INCREMENT = 0x40; ///< Multi-byte address bit
+
+  /**
+   * @brief Creates the transport
+   *
+   * @param spi The SPI object to use
+   */
+  Adafruit_HTS221_LiteSPI(SPIClass *spi = &SPI) : _spi(spi) {}
+
+  /**
+   * @brief Sets up the chip select pin and starts the SPI bus
+   *
+   * @return true
+   */
+  bool begin(void) {
+    pinMode(CS_PIN, OUTPUT);
+    digitalWrite(CS_PIN, HIGH);
+    _spi->begin();
+    return true;
+  }
+
+  /**
+   * @brief Reads consecutive registers in one chip select frame
+   *
+   * @param reg The first register, including any auto-increment bit
+   * @param buffer Where to put the register values
+   * @param len The number of registers to read
+   * @return true
+   */
+  bool read(uint8_t reg, uint8_t *buffer, uint8_t len) {
+    _select();
+    _spi->transfer(reg | 0x80); // read bit
+    for (uint8_t i = 0; i < len; i++) {
+      buffer[i] = _spi->transfer(0xFF);
+    }
+    _deselect();
+    return true;
+  }
+
+  /**
+   * @brief Writes consecutive registers in one chip select frame
+   *
+   * @param reg The first register, including any auto-increment bit
+   * @param buffer The register values
+   * @param len The number of registers to write
+   * @return true
+   */
+  bool write(uint8_t reg, const uint8_t *buffer, uint8_t len) {
+    _select();
+    _spi->transfer(reg);
+    for (uint8_t i = 0; i < len; i++) {
+      _spi->transfer(buffer[i]);
+    }
+    _deselect();
+    return true;
+  }
+
+private:
+  SPIClass *_spi;
+
+  void _select(void) {
+    _spi->beginTransaction(SPISettings(FREQUENCY, MSBFIRST, SPI_MODE0));
+    digitalWrite(CS_PIN, LOW);
+  }
+  void _deselect(void) {
+    digitalWrite(CS_PIN, HIGH);
+    _spi->endTransaction();
+  }
+};
+
+/**
+ * @brief A minimal HTS221 driver specialized for one transport
+ *
+ * Any class with a static `AUTO_INCREMENT` constant and `begin()`,
+ * `read(reg, buffer, len)` and `write(reg, buffer, len)` members can be used
+ * as the transport.
+ *
+ * @tparam Transport `Adafruit_HTS221_LiteI2C` or `Adafruit_HTS221_LiteSPI`
+ */
+template <class Transport> class Adafruit_HTS221_Lite {
+public:
+  /**
+   * @brief Creates the driver
+   *
+   * @param transport The bus to talk to the sensor over
+   */
+  Adafruit_HTS221_Lite(const Transport &transport = Transport())
+      : _bus(transport) {}
+
+  /**
+   * @brief Checks the chip ID, powers the sensor up and loads its
+   * calibration. AV_CONF, CTRL_REG2 and CTRL_REG3 are left as they are.
+   *
+   * @param data_rate The output data rate to run at
+   * @return true if the sensor was found and set up
+   */
+  bool begin(hts221_rate_t data_rate = HTS221_RATE_12_5_HZ) {
+    uint8_t buffer[HTS221_CAL_BLOCK_LEN];
+    if (!_bus.begin() || !_bus.read(HTS221_WHOAMI, buffer, 1) ||
+        buffer[0] != HTS221_CHIP_ID) {
+      return false;
+    }
+    uint8_t ctrl_1 = HTS221_CTRL_1_PD | HTS221_CTRL_1_BDU | data_rate;
+    if (!_bus.write(HTS221_CTRL_REG_1, &ctrl_1, 1)) {
+      return false;
+    }
+    if (!_bus.read(CALIBRATION, buffer, HTS221_CAL_BLOCK_LEN)) {
+      return false;
+    }
+    hts221_calibration_t calibration;
+    hts221_parseCalibration(buffer, &calibration);
+    hts221_computeCoeffs(&calibration, &_coeffs);
+    return true;
+  }
+
+  /**
+   * @brief Reads the latest raw output counts in one burst
+   *
+   * @param temperature Set to the raw TEMP_OUT value
+   * @param humidity Set to the raw HUMIDITY_OUT value
+   * @return true if the read succeeded
+   */
+  bool readRaw(int16_t *temperature, int16_t *humidity) {
+    uint8_t buffer[4];
+    if (!_bus.read(OUTPUTS, buffer, 4)) {
+      return false;
+    }
+    *humidity = (int16_t)(buffer[0] | (buffer[1] << 8));
+    *temperature = (int16_t)(buffer[2] | (buffer[3] << 8));
+    return true;
+  }
+
+  /**
+   * @brief Reads the latest values in hundredths of a unit
+   *
+   * @param temperature Set to the temperature in centi-degrees C
+   * @param humidity Set to the relative humidity in centi-%RH
+   * @return true if the read succeeded
+   */
+  bool readCenti(int16_t *temperature, int16_t *humidity) {
+    int16_t raw_temperature, raw_humidity;
+    if (!readRaw(&raw_temperature, &raw_humidity)) {
+      return false;
+    }
+    *temperature = hts221_centiTemperature(&_coeffs, raw_temperature);
+    *humidity = hts221_centiHumidity(&_coeffs, raw_humidity);
+    return true;
+  }
+
+  /**
+   * @brief Gets the fixed-point coefficients folded from the calibration,
+   * for converting readings from `readRaw()` later
+   *
+   * @return const hts221_coeffs_t* The coefficients
+   */
+  const hts221_coeffs_t *getCoefficients(void) { return &_coeffs; }
+
+private:
+  // burst addresses with the transport's auto-increment bit folded in
+  static const uint8_t CALIBRATION =
+      HTS221_H0_RH_X2 | Transport::AUTO_INCREMENT;
+  static const uint8_t OUTPUTS =
+      HTS221_HUMIDITY_OUT | Transport::AUTO_INCREMENT;
+
+  Transport _bus;
+  hts221_coeffs_t _coeffs = {};
+};
+
+#endif
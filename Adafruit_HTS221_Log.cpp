@@ -0,0 +1,274 @@
+/*!
+ *  @file Adafruit_HTS221_Log.cpp
+ *
+ * 	Compact binary log of raw samples for the Adafruit HTS221 Humidity and
+ * 	Temperature Sensor library
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_HTS221_Log.h"
+#include <string.h>
+
+// the first bytes of every log
+static const uint8_t _magic[3] = {'H', 'T', 'S'};
+
+// writes an unsigned LEB128 varint, returning the number of bytes used
+static uint8_t _putVarint(uint8_t *out, uint32_t value) {
+  uint8_t count = 0;
+  while (value >= 0x80) {
+    out[count++] = (uint8_t)value | 0x80;
+    value >>= 7;
+  }
+  out[count++] = (uint8_t)value;
+  return count;
+}
+
+// maps small negative and positive deltas to small unsigned values
+static uint32_t _zigzag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t _unzigzag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static void _putLE16(uint8_t *out, uint16_t value) {
+  out[0] = value & 0xFF;
+  out[1] = value >> 8;
+}
+
+static uint16_t _getLE16(const uint8_t *in) {
+  return (uint16_t)in[0] | ((uint16_t)in[1] << 8);
+}
+
+/*!
+ *    @brief  Creates an encoder writing into a fixed buffer
+ *    @param  buffer Where to put the encoded log
+ *    @param  size The size of `buffer`; at least HTS221_LOG_MAX_HEADER
+ */
+Adafruit_HTS221_LogEncoder::Adafruit_HTS221_LogEncoder(uint8_t *buffer,
+                                                       size_t size)
+    : _buffer(buffer), _size(size), _length(0), _tick_us(1000), _last_us(0),
+      _last_temp(0), _last_humid(0) {}
+
+/*!
+ *    @brief  Starts a new log, writing the header to the start of the buffer
+ *    @param  calibration The calibration of the sensor the samples come from
+ *    @param  tick_us The timestamp resolution in microseconds. Sample times
+ *            are rounded down to a whole number of ticks
+ *    @return True if the header fit in the buffer
+ */
+bool Adafruit_HTS221_LogEncoder::begin(const hts221_calibration_t *calibration,
+                                       uint16_t tick_us) {
+  _length = 0;
+  _last_us = 0;
+  _last_temp = 0;
+  _last_humid = 0;
+  _tick_us = tick_us ? tick_us : 1;
+  if (_size < HTS221_LOG_MAX_HEADER) {
+    return false;
+  }
+
+  uint8_t *out = _buffer;
+  memcpy(out, _magic, sizeof(_magic));
+  out += sizeof(_magic);
+  *out++ = HTS221_LOG_VERSION;
+  out += _putVarint(out, _tick_us);
+
+  // field by field so the log doesn't depend on the struct layout
+  *out++ = calibration->chip_id;
+  *out++ = calibration->h0_rh_x2;
+  *out++ = calibration->h1_rh_x2;
+  *out++ = calibration->reserved;
+  const uint16_t words[] = {calibration->t0_degc,   calibration->t1_degc,
+                            calibration->t0_out,    calibration->t1_out,
+                            calibration->h0_t0_out, calibration->h1_t0_out,
+                            calibration->crc};
+  for (uint8_t i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+    _putLE16(out, words[i]);
+    out += 2;
+  }
+  _length = out - _buffer;
+  return true;
+}
+
+/*!
+ *    @brief  Appends a sample to the log
+ *    @param  sample The sample to add. Samples must be added in time order
+ *    @return True if it was added, false if the buffer is too full. Nothing
+ *            is written in that case, so the sample can be added again after
+ *            the buffer is written out and cleared
+ */
+bool Adafruit_HTS221_LogEncoder::add(const hts221_raw_sample_t *sample) {
+  if (_size - _length < HTS221_LOG_MAX_RECORD) {
+    return false;
+  }
+  uint32_t ticks = (sample->timestamp_us - _last_us) / _tick_us;
+
+  uint8_t *out = _buffer + _length;
+  out += _putVarint(out, ticks);
+  out += _putVarint(out, _zigzag((int32_t)sample->temperature - _last_temp));
+  out += _putVarint(out, _zigzag((int32_t)sample->humidity - _last_humid));
+  _length = out - _buffer;
+
+  // track the timestamp the decoder will see so rounding doesn't build up
+  _last_us += ticks * _tick_us;
+  _last_temp = sample->temperature;
+  _last_humid = sample->humidity;
+  return true;
+}
+
+/*!
+ *    @brief  Gets the encoded bytes not yet cleared
+ *    @return The start of the buffer
+ */
+const uint8_t *Adafruit_HTS221_LogEncoder::data(void) { return _buffer; }
+
+/*!
+ *    @brief  Gets the number of encoded bytes not yet cleared
+ *    @return The number of bytes at `data()`
+ */
+size_t Adafruit_HTS221_LogEncoder::length(void) { return _length; }
+
+/*!
+ *    @brief  Empties the buffer once its contents have been written out. The
+ *            log carries on from the last sample, so the next bytes follow
+ *            on from the ones just written
+ */
+void Adafruit_HTS221_LogEncoder::clear(void) { _length = 0; }
+
+/*!
+ *    @brief  Creates a decoder
+ */
+Adafruit_HTS221_LogDecoder::Adafruit_HTS221_LogDecoder(void)
+    : _data(NULL), _length(0), _position(0), _tick_us(1), _last_us(0),
+      _last_temp(0), _last_humid(0) {
+  memset(&_calibration, 0, sizeof(_calibration));
+  memset(&_coeffs, 0, sizeof(_coeffs));
+}
+
+/*!
+ *    @brief  Starts decoding a log, reading its header
+ *    @param  data The log, or its first chunk
+ *    @param  length The number of bytes at `data`
+ *    @return True if the header is valid and its calibration passes its CRC
+ */
+bool Adafruit_HTS221_LogDecoder::begin(const uint8_t *data, size_t length) {
+  feed(data, length);
+  _last_us = 0;
+  _last_temp = 0;
+  _last_humid = 0;
+
+  uint32_t tick_us;
+  if (length < sizeof(_magic) + 1 ||
+      memcmp(data, _magic, sizeof(_magic)) != 0 ||
+      data[sizeof(_magic)] != HTS221_LOG_VERSION) {
+    return false;
+  }
+  _position = sizeof(_magic) + 1;
+  if (!_readVarint(&tick_us) || tick_us == 0 || tick_us > 0xFFFF ||
+      _length - _position < 18) {
+    return false;
+  }
+  _tick_us = tick_us;
+
+  const uint8_t *in = _data + _position;
+  _calibration.chip_id = in[0];
+  _calibration.h0_rh_x2 = in[1];
+  _calibration.h1_rh_x2 = in[2];
+  _calibration.reserved = in[3];
+  _calibration.t0_degc = _getLE16(&in[4]);
+  _calibration.t1_degc = _getLE16(&in[6]);
+  _calibration.t0_out = _getLE16(&in[8]);
+  _calibration.t1_out = _getLE16(&in[10]);
+  _calibration.h0_t0_out = _getLE16(&in[12]);
+  _calibration.h1_t0_out = _getLE16(&in[14]);
+  _calibration.crc = _getLE16(&in[16]);
+  _position += 18;
+
+  if (_calibration.crc != hts221_calibrationCRC(&_calibration)) {
+    return false;
+  }
+  hts221_computeCoeffs(&_calibration, &_coeffs);
+  return true;
+}
+
+/*!
+ *    @brief  Continues decoding with the next chunk of a log written out
+ *            from an encoder's buffer between `clear()` calls
+ *    @param  data The chunk
+ *    @param  length The number of bytes at `data`
+ */
+void Adafruit_HTS221_LogDecoder::feed(const uint8_t *data, size_t length) {
+  _data = data;
+  _length = length;
+  _position = 0;
+}
+
+/*!
+ *    @brief  Decodes the next sample
+ *    @param  sample Set to the sample. The raw counts are exactly the ones
+ *            encoded; the timestamp is rounded down to the log's tick
+ *    @return True if a sample was decoded, false at the end of the data or
+ *            if it is truncated
+ */
+bool Adafruit_HTS221_LogDecoder::next(hts221_raw_sample_t *sample) {
+  size_t start = _position;
+  uint32_t ticks, temp_delta, humid_delta;
+  if (!_readVarint(&ticks) || !_readVarint(&temp_delta) ||
+      !_readVarint(&humid_delta)) {
+    _position = start;
+    return false;
+  }
+  _last_us += ticks * _tick_us;
+  _last_temp = (int16_t)(_last_temp + _unzigzag(temp_delta));
+  _last_humid = (int16_t)(_last_humid + _unzigzag(humid_delta));
+
+  sample->timestamp_us = _last_us;
+  sample->temperature = _last_temp;
+  sample->humidity = _last_humid;
+  return true;
+}
+
+/*!
+ *    @brief  Gets the calibration stored in the log header
+ *    @return The calibration
+ */
+const hts221_calibration_t *Adafruit_HTS221_LogDecoder::getCalibration(void) {
+  return &_calibration;
+}
+
+/*!
+ *    @brief  Gets the conversion coefficients for the logged sensor, for use
+ *            with `hts221_centiTemperature()` and the other conversions
+ *    @return The coefficients
+ */
+const hts221_coeffs_t *Adafruit_HTS221_LogDecoder::getCoefficients(void) {
+  return &_coeffs;
+}
+
+/*!
+ *    @brief  Reads an unsigned varint
+ *    @param  value Set to the value
+ *    @return True if a complete varint was read
+ */
+bool Adafruit_HTS221_LogDecoder::_readVarint(uint32_t *value) {
+  uint32_t result = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (_position >= _length) {
+      return false;
+    }
+    uint8_t in = _data[_position++];
+    result |= (uint32_t)(in & 0x7F) << shift;
+    if (!(in & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
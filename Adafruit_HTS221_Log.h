@@ -0,0 +1,83 @@
+/*!
+ *  @file Adafruit_HTS221_Log.h
+ *
+ * 	Compact binary log of raw samples for the Adafruit HTS221 Humidity and
+ * 	Temperature Sensor library. Has no Arduino dependencies so logs can be
+ * 	decoded on any host.
+ *
+ * 	A log starts with a header holding the sensor's decoded calibration. Each
+ * 	sample after it is three varints: the timestamp delta in ticks and the
+ * 	zigzag-encoded deltas of the raw temperature and humidity counts. A slowly
+ * 	changing reading at a steady rate takes 3 bytes per sample.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_LOG_H
+#define _ADAFRUIT_HTS221_LOG_H
+
+#include "Adafruit_HTS221_Convert.h"
+
+#define HTS221_LOG_VERSION 1     ///< Format version written in the header
+#define HTS221_LOG_MAX_HEADER 25 ///< Most bytes a log header can take
+#define HTS221_LOG_MAX_RECORD 11 ///< Most bytes one sample can take
+
+/*!
+ *    @brief  Appends samples to a log in a fixed, caller provided buffer.
+ *            When the buffer fills, write it out, call `clear()` and carry
+ *            on; the chunks written out join up into one log
+ */
+class Adafruit_HTS221_LogEncoder {
+public:
+  Adafruit_HTS221_LogEncoder(uint8_t *buffer, size_t size);
+
+  bool begin(const hts221_calibration_t *calibration, uint16_t tick_us = 1000);
+  bool add(const hts221_raw_sample_t *sample);
+  const uint8_t *data(void);
+  size_t length(void);
+  void clear(void);
+
+private:
+  uint8_t *_buffer;    ///< Caller provided output buffer
+  size_t _size;        ///< Size of `_buffer`
+  size_t _length;      ///< Bytes in `_buffer` not yet cleared
+  uint16_t _tick_us;   ///< Timestamp resolution
+  uint32_t _last_us;   ///< Timestamp of the last sample, as decoded
+  int16_t _last_temp;  ///< Raw temperature of the last sample
+  int16_t _last_humid; ///< Raw humidity of the last sample
+};
+
+/*!
+ *    @brief  Reads samples back out of a log made by
+ *            `Adafruit_HTS221_LogEncoder`
+ */
+class Adafruit_HTS221_LogDecoder {
+public:
+  Adafruit_HTS221_LogDecoder(void);
+
+  bool begin(const uint8_t *data, size_t length);
+  void feed(const uint8_t *data, size_t length);
+  bool next(hts221_raw_sample_t *sample);
+  const hts221_calibration_t *getCalibration(void);
+  const hts221_coeffs_t *getCoefficients(void);
+
+private:
+  const uint8_t *_data;              ///< Log bytes being decoded
+  size_t _length;                    ///< Size of `_data`
+  size_t _position;                  ///< Next byte of `_data` to decode
+  uint16_t _tick_us;                 ///< Timestamp resolution
+  uint32_t _last_us;                 ///< Timestamp of the last sample
+  int16_t _last_temp;                ///< Raw temperature of the last sample
+  int16_t _last_humid;               ///< Raw humidity of the last sample
+  hts221_calibration_t _calibration; ///< Calibration from the header
+  hts221_coeffs_t _coeffs;           ///< Coefficients for `_calibration`
+
+  bool _readVarint(uint32_t *value);
+};
+
+#endif
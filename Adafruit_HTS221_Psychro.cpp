@@ -0,0 +1,213 @@
+/*!
+ *  @file Adafruit_HTS221_Psychro.cpp
+ *
+ * 	Dew point, absolute humidity and heat index for the Adafruit HTS221
+ * 	Humidity and Temperature Sensor library
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "Adafruit_HTS221_Psychro.h"
+#include <math.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#endif
+
+// log2(1 + i/32) and 2^(i/32) - 1, in 1/65536ths
+static const uint16_t _log2_table[32] PROGMEM = {
+    0,     2909,  5732,  8473,  11136, 13727, 16248, 18704,
+    21098, 23433, 25711, 27936, 30109, 32234, 34312, 36346,
+    38336, 40286, 42196, 44068, 45904, 47705, 49472, 51207,
+    52911, 54584, 56229, 57845, 59434, 60997, 62534, 64047};
+static const uint16_t _exp2_table[32] PROGMEM = {
+    0,     1435,  2902,  4400,  5932,  7496,  9096,  10730,
+    12400, 14106, 15850, 17633, 19454, 21315, 23216, 25160,
+    27146, 29175, 31249, 33369, 35534, 37747, 40009, 42320,
+    44682, 47095, 49562, 52082, 54658, 57289, 59979, 62727};
+
+#define LOG2_10000 870819 ///< log2(10000) in 1/65536ths
+#define MAGNUS_A2 2542    ///< Magnus a / ln(2), in hundredths
+#define MAGNUS_B 24312    ///< Magnus b in hundredths of a degree C
+
+// interpolates a 32 entry table over [0, 1); the entry after the last is
+// 65536 in both tables
+static uint32_t _lookup(const uint16_t *table, uint16_t fraction) {
+  uint8_t index = fraction >> 11;
+  uint32_t low = pgm_read_word(&table[index]);
+  uint32_t high = index < 31 ? pgm_read_word(&table[index + 1]) : 65536;
+  return low + (((high - low) * (fraction & 0x7FF)) >> 11);
+}
+
+// log2(value) in 1/65536ths, for value > 0
+static int32_t _log2(uint32_t value) {
+  int32_t exponent = 31;
+  while (!(value & 0x80000000)) {
+    value <<= 1;
+    exponent--;
+  }
+  // the bits below the leading one are the mantissa's fraction
+  return exponent * 65536 + _lookup(_log2_table, (uint16_t)(value >> 15));
+}
+
+// num / den in 1/65536ths, for 0 < den < 2^22 and |num / den| < 2^15; long
+// division so no 64-bit arithmetic is needed
+static int32_t _divQ16(int32_t num, int32_t den) {
+  uint32_t n = num < 0 ? -(uint32_t)num : num;
+  uint32_t quotient = n / den;
+  uint32_t remainder = (n % den) << 9;
+  uint32_t high = remainder / den;
+  remainder = (remainder % den) << 7;
+  quotient = (quotient << 16) | (high << 7) | (remainder / den);
+  return num < 0 ? -(int32_t)quotient : (int32_t)quotient;
+}
+
+// ln(e / 6.112 hPa) / ln(2) in 1/65536ths, where e is the vapor pressure;
+// both dew point and absolute humidity follow from this
+static int32_t _magnusLog2(int16_t temperature, int16_t humidity) {
+  if (humidity < 1) {
+    humidity = 1;
+  }
+  int32_t humidity_log2 = _log2(humidity) - LOG2_10000;
+  int32_t magnus_log2 = _divQ16((int32_t)MAGNUS_A2 * temperature,
+                                100L * (MAGNUS_B + temperature));
+  return humidity_log2 + magnus_log2;
+}
+
+static int16_t _dewPoint(int32_t gamma) {
+  // Td = b * gamma / (a - gamma), with gamma in log2 units and 1/4096ths
+  int32_t gamma_q12 = (gamma + 8) >> 4;
+  int32_t den = (int32_t)MAGNUS_A2 * 4096 / 100 - gamma_q12;
+  int32_t num = (int32_t)MAGNUS_B * gamma_q12;
+  return (int16_t)((num + (num < 0 ? -den / 2 : den / 2)) / den);
+}
+
+static int32_t _absoluteHumidity(int16_t temperature, int32_t gamma) {
+  // AH = 216.7 * 6.112 * 2^gamma / T(K) g/m^3; scale is 100 * that constant
+  // over the absolute temperature in hundredths, in 1/16ths
+  uint32_t scale = 211915264UL / (uint32_t)(27315 + temperature);
+  int32_t exponent = gamma >> 16;
+  uint32_t mantissa = 65536 + _lookup(_exp2_table, (uint16_t)gamma);
+  int32_t shift = 20 - exponent;
+  if (shift >= 32) {
+    return 0;
+  }
+  return (int32_t)((scale * mantissa + (1UL << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief Computes the dew point from readings in hundredths
+ *
+ * @param temperature The temperature in centi-degrees C
+ * @param humidity The relative humidity in centi-%RH
+ * @return int16_t The dew point in centi-degrees C
+ */
+int16_t hts221_dewPointCenti(int16_t temperature, int16_t humidity) {
+  return _dewPoint(_magnusLog2(temperature, humidity));
+}
+
+/**
+ * @brief Computes the absolute humidity from readings in hundredths
+ *
+ * @param temperature The temperature in centi-degrees C
+ * @param humidity The relative humidity in centi-%RH
+ * @return int32_t The water vapor density in hundredths of a g/m^3
+ */
+int32_t hts221_absoluteHumidityCenti(int16_t temperature, int16_t humidity) {
+  return _absoluteHumidity(temperature, _magnusLog2(temperature, humidity));
+}
+
+/**
+ * @brief Computes the NWS heat index from readings in hundredths. Below about
+ * 27 C, where the regression doesn't apply, this is close to the temperature
+ *
+ * @param temperature The temperature in centi-degrees C
+ * @param humidity The relative humidity in centi-%RH
+ * @return int16_t The heat index in centi-degrees C
+ */
+int16_t hts221_heatIndexCenti(int16_t temperature, int16_t humidity) {
+  // https://www.wpc.ncep.noaa.gov/html/heatindex_equation.shtml
+  float t = temperature * 0.018f + 32; // degrees F
+  float rh = humidity * 0.01f;
+  float hi = 0.5f * (t + 61.0f + (t - 68.0f) * 1.2f + rh * 0.094f);
+  if (hi + t >= 160.0f) {
+    hi = -42.379f + 2.04901523f * t + 10.14333127f * rh -
+         0.22475541f * t * rh - 0.00683783f * t * t - 0.05481717f * rh * rh +
+         0.00122874f * t * t * rh + 0.00085282f * t * rh * rh -
+         0.00000199f * t * t * rh * rh;
+    if (rh < 13 && t >= 80 && t <= 112) {
+      hi -= (13 - rh) * 0.25f * sqrtf((17 - fabsf(t - 95)) / 17);
+    } else if (rh > 85 && t >= 80 && t <= 87) {
+      hi += (rh - 85) * 0.1f * (87 - t) * 0.2f;
+    }
+  }
+  // the regression runs away at extremes well past where it means anything
+  float centi = (hi - 32) * (500.0f / 9);
+  if (centi > 32767) {
+    return 32767;
+  }
+  return (int16_t)(centi < 0 ? centi - 0.5f : centi + 0.5f);
+}
+
+/**
+ * @brief Computes all of the derived metrics for one reading, sharing the
+ * work the dew point and absolute humidity have in common
+ *
+ * @param temperature The temperature in centi-degrees C
+ * @param humidity The relative humidity in centi-%RH
+ * @param metrics Set to the results
+ */
+void hts221_psychrometrics(int16_t temperature, int16_t humidity,
+                           hts221_psychro_t *metrics) {
+  int32_t gamma = _magnusLog2(temperature, humidity);
+  metrics->dew_point = _dewPoint(gamma);
+  metrics->absolute_humidity = _absoluteHumidity(temperature, gamma);
+  metrics->heat_index = hts221_heatIndexCenti(temperature, humidity);
+}
+
+// rounds a float reading to hundredths
+static int16_t _centi(float value) {
+  return (int16_t)(value < 0 ? value * 100 - 0.5f : value * 100 + 0.5f);
+}
+
+/**
+ * @brief Computes the dew point
+ *
+ * @param temperature The temperature in degrees C
+ * @param humidity The relative humidity in percent
+ * @return float The dew point in degrees C
+ */
+float hts221_dewPoint(float temperature, float humidity) {
+  return hts221_dewPointCenti(_centi(temperature), _centi(humidity)) / 100.0f;
+}
+
+/**
+ * @brief Computes the absolute humidity
+ *
+ * @param temperature The temperature in degrees C
+ * @param humidity The relative humidity in percent
+ * @return float The water vapor density in g/m^3
+ */
+float hts221_absoluteHumidity(float temperature, float humidity) {
+  return hts221_absoluteHumidityCenti(_centi(temperature), _centi(humidity)) /
+         100.0f;
+}
+
+/**
+ * @brief Computes the NWS heat index
+ *
+ * @param temperature The temperature in degrees C
+ * @param humidity The relative humidity in percent
+ * @return float The heat index in degrees C
+ */
+float hts221_heatIndex(float temperature, float humidity) {
+  return hts221_heatIndexCenti(_centi(temperature), _centi(humidity)) /
+         100.0f;
+}
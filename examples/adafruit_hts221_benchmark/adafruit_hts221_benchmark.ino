@@ -0,0 +1,83 @@
+// Times the driver's common operations against a real sensor so changes to
+// the bus traffic can be compared before and after
+
+#include <Adafruit_HTS221.h>
+
+#define ITERATIONS 100
+
+Adafruit_HTS221 hts;
+hts221_calibration_t calibration;
+
+void report(const char *name, uint32_t elapsed_us, uint16_t count) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((float)elapsed_us / count);
+  Serial.println(" us");
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 benchmark");
+
+  uint32_t start = micros();
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  report("Cold begin", micros() - start, 1);
+  hts.getCalibration(&calibration);
+
+  // restarting with the saved calibration skips the boot and block read
+  start = micros();
+  hts.begin_I2C(&calibration);
+  report("Warm begin", micros() - start, 1);
+
+  sensors_event_t temp, humidity;
+  hts.resetCacheStats();
+  start = micros();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    hts.getEvent(&humidity, &temp);
+  }
+  report("getEvent", micros() - start, ITERATIONS);
+
+  int16_t centi_temp, centi_humidity;
+  start = micros();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    hts.readCenti(&centi_temp, &centi_humidity);
+  }
+  report("readCenti", micros() - start, ITERATIONS);
+
+  Adafruit_Sensor *temp_sensor = hts.getTemperatureSensor();
+  Adafruit_Sensor *humidity_sensor = hts.getHumiditySensor();
+  start = micros();
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    temp_sensor->getEvent(&temp);
+    humidity_sensor->getEvent(&humidity);
+  }
+  report("Unified pair", micros() - start, ITERATIONS);
+
+  uint32_t hits, misses;
+  hts.getCacheStats(&hits, &misses);
+  Serial.print("Cache hits: ");
+  Serial.print(hits);
+  Serial.print(" misses: ");
+  Serial.println(misses);
+
+  // one shot conversions, from the trigger until both values are ready
+  hts.setActive(false);
+  start = micros();
+  for (uint16_t i = 0; i < 10; i++) {
+    hts.startOneShot();
+    while (!hts.pollOneShot()) {
+      delay(1);
+    }
+  }
+  report("One shot", micros() - start, 10);
+}
+
+void loop() { delay(1000); }
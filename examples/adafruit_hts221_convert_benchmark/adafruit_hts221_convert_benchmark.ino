@@ -0,0 +1,70 @@
+// Compares converting an array of raw readings one at a time with the float
+// divide the driver used to do against the bulk conversion functions, and
+// reports samples per second for each
+
+#include <Adafruit_HTS221.h>
+
+#define SAMPLE_COUNT 256
+
+Adafruit_HTS221 hts;
+
+int16_t raw[SAMPLE_COUNT];
+float temperatures[SAMPLE_COUNT];
+int16_t centi_temperatures[SAMPLE_COUNT];
+
+void report(const char *name, uint32_t elapsed_us) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(elapsed_us);
+  Serial.print(" us, ");
+  Serial.print(SAMPLE_COUNT * 1000000.0 / elapsed_us);
+  Serial.println(" samples/s");
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 conversion benchmark");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  const hts221_coeffs_t *coeffs = hts.getCoefficients();
+  hts221_calibration_t cal;
+  hts.getCalibration(&cal);
+
+  // a spread of raw readings around room temperature
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    raw[i] = (int16_t)(i * 8 - 1024);
+  }
+
+  // one sample at a time, evaluating the calibration line with a float
+  // divide the way the driver did before the fixed-point coefficients
+  int16_t t0 = (int16_t)cal.t0_degc;
+  int16_t t1 = (int16_t)cal.t1_degc;
+  int16_t t0_out = (int16_t)cal.t0_out;
+  int16_t t1_out = (int16_t)cal.t1_out;
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    temperatures[i] = (float)(raw[i] - t0_out) * (float)(t1 - t0) /
+                          (float)(t1_out - t0_out) +
+                      t0;
+  }
+  report("Scalar float divide", micros() - start);
+
+  start = micros();
+  hts221_convertTemperatures(coeffs, raw, temperatures, SAMPLE_COUNT);
+  report("Bulk float", micros() - start);
+
+  start = micros();
+  hts221_convertTemperaturesCenti(coeffs, raw, centi_temperatures,
+                                  SAMPLE_COUNT);
+  report("Bulk centi-degrees", micros() - start);
+}
+
+void loop() { delay(1000); }
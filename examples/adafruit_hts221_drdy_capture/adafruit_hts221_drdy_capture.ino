@@ -0,0 +1,63 @@
+// Demo for capturing samples on the HTS221's DRDY pin into a buffer and
+// draining them in batches
+
+#include <Adafruit_HTS221.h>
+
+// The pin connected to DRDY; it must support interrupts
+#define HTS_DRDY 2
+
+Adafruit_HTS221 hts;
+
+hts221_raw_sample_t sample_storage[16];
+Adafruit_HTS221_SampleBuffer samples(sample_storage, 16);
+
+void onDataReady(void) { hts.dataReady(); }
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 DRDY capture test!");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  Serial.println("HTS221 Found!");
+
+  pinMode(HTS_DRDY, INPUT);
+  attachInterrupt(digitalPinToInterrupt(HTS_DRDY), onDataReady, RISING);
+  hts.startCapture(&samples);
+}
+
+void loop() {
+  // move any flagged sample into the buffer
+  hts.service();
+
+  // pretend to be a slow uplink task that only runs once a second
+  static uint32_t last_drain = 0;
+  if (millis() - last_drain < 1000) {
+    return;
+  }
+  last_drain = millis();
+
+  hts221_raw_sample_t batch[16];
+  uint8_t count = samples.pop(batch, 16);
+  const hts221_coeffs_t *coeffs = hts.getCoefficients();
+
+  Serial.print(count);
+  Serial.print(" samples, ");
+  Serial.print(hts.getDroppedSamples());
+  Serial.println(" dropped");
+  for (uint8_t i = 0; i < count; i++) {
+    Serial.print(batch[i].timestamp_us);
+    Serial.print(" us: ");
+    Serial.print(hts221_centiTemperature(coeffs, batch[i].temperature) / 100.0);
+    Serial.print(" degrees C, ");
+    Serial.print(hts221_centiHumidity(coeffs, batch[i].humidity) / 100.0);
+    Serial.println("% rH");
+  }
+}
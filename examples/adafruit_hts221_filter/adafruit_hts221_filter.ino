@@ -0,0 +1,41 @@
+// Smooths readings on the raw counts before they are converted: a 3 sample
+// median drops spikes, a moving average over about 4 samples smooths the
+// rest, and only one sample in 4 comes out the end and gets converted
+
+#include <Adafruit_HTS221.h>
+
+Adafruit_HTS221 hts;
+Adafruit_HTS221_Filter filter(3, 2, 4);
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 filter test");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  hts.setDataRate(HTS221_RATE_12_5_HZ);
+  hts.setFilter(&filter);
+}
+
+void loop() {
+  // at 12.5 Hz with 4:1 decimation there's a new reading about 3 times a
+  // second
+  hts221_raw_record_t record;
+  int16_t temperature, humidity;
+  if (hts.readBatch(&record, 1)) {
+    hts.convertBatch(&record, 1, &temperature, &humidity);
+    Serial.print("Temperature: ");
+    Serial.print(temperature / 100.0);
+    Serial.print(" C, humidity: ");
+    Serial.print(humidity / 100.0);
+    Serial.println(" %RH");
+  }
+  delay(20);
+}
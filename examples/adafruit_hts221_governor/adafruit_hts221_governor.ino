@@ -0,0 +1,59 @@
+// Lets the data rate follow the readings: the sensor drops to a one shot
+// every 10 seconds while the room is steady and speeds up to 12.5 Hz when
+// the temperature or humidity starts to change. Breathe on the sensor to
+// see it step up.
+
+#include <Adafruit_HTS221_Governor.h>
+
+Adafruit_HTS221 hts;
+Adafruit_HTS221_Governor governor(&hts);
+
+const char *rateName(hts221_rate_t data_rate) {
+  switch (data_rate) {
+  case HTS221_RATE_ONE_SHOT:
+    return "one shot";
+  case HTS221_RATE_1_HZ:
+    return "1 Hz";
+  case HTS221_RATE_7_HZ:
+    return "7 Hz";
+  default:
+    return "12.5 Hz";
+  }
+}
+
+void rateChanged(hts221_rate_t from, hts221_rate_t to) {
+  Serial.print("Data rate ");
+  Serial.print(rateName(from));
+  Serial.print(" -> ");
+  Serial.println(rateName(to));
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 data rate governor");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  governor.onTransition(rateChanged);
+  governor.setHoldTime(10000);
+  governor.begin();
+}
+
+void loop() {
+  int16_t temperature, humidity;
+  if (governor.update(&temperature, &humidity)) {
+    Serial.print("Temperature: ");
+    Serial.print(temperature / 100.0);
+    Serial.print(" C, humidity: ");
+    Serial.print(humidity / 100.0);
+    Serial.println(" %RH");
+  }
+  delay(5);
+}
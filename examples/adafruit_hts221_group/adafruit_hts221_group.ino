@@ -0,0 +1,61 @@
+// Reads four HTS221s that share the fixed 0x5F address by putting them
+// behind TCA9548A muxes. The group starts every sensor's one shot
+// conversion before collecting any of them, so one read() takes about as
+// long as a single conversion. A sensor that didn't respond is marked
+// invalid instead of repeating its last reading.
+
+#include <Adafruit_HTS221_Group.h>
+
+#define SENSOR_COUNT 4
+
+Adafruit_HTS221 sensors[SENSOR_COUNT];
+// the group keeps its sensors and results here, sized for this sketch
+hts221_group_member_t members[SENSOR_COUNT];
+hts221_group_reading_t readings[SENSOR_COUNT];
+Adafruit_HTS221_Group group(members, readings, SENSOR_COUNT);
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 group test");
+
+  // two sensors on channels 0 and 1 of each of the muxes at 0x70 and 0x71
+  for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+    uint8_t mux_address = (i < 2) ? 0x70 : 0x71;
+    if (!group.add(&sensors[i], &Wire, mux_address, i % 2)) {
+      Serial.println("Couldn't add sensor");
+    }
+  }
+  if (!group.begin()) {
+    Serial.println("Not every sensor was found; carrying on with the rest");
+  }
+}
+
+void loop() {
+  hts221_group_snapshot_t snapshot;
+  group.read(&snapshot);
+
+  for (uint8_t i = 0; i < snapshot.count; i++) {
+    Serial.print("Sensor ");
+    Serial.print(i);
+    if (!snapshot.readings[i].valid) {
+      Serial.println(": no reading");
+      continue;
+    }
+    Serial.print(": ");
+    Serial.print(snapshot.readings[i].temperature / 100.0);
+    Serial.print(" C, ");
+    Serial.print(snapshot.readings[i].humidity / 100.0);
+    Serial.println(" %RH");
+  }
+  Serial.print("Read took ");
+  Serial.print(snapshot.latency_us);
+  Serial.print(" us with ");
+  Serial.print(snapshot.mux_switches);
+  Serial.println(" mux switches");
+  Serial.println();
+
+  delay(1000);
+}
@@ -0,0 +1,48 @@
+// Reads the sensor with the small fixed-bus driver, for boards where the
+// full driver's flash use is too much. Prints hundredths as fixed point.
+
+#include <Adafruit_HTS221_Lite.h>
+
+// For SPI mode, we need a CS pin
+#define HTS_CS 10
+
+Adafruit_HTS221_Lite<Adafruit_HTS221_LiteI2C<> > hts;
+// Adafruit_HTS221_Lite<Adafruit_HTS221_LiteSPI<HTS_CS> > hts;
+
+void printCenti(int16_t value) {
+  if (value < 0) {
+    Serial.print('-');
+    value = -value;
+  }
+  Serial.print(value / 100);
+  Serial.print('.');
+  if (value % 100 < 10) {
+    Serial.print('0');
+  }
+  Serial.print(value % 100);
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  if (!hts.begin()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+}
+
+void loop() {
+  int16_t temperature, humidity;
+  if (hts.readCenti(&temperature, &humidity)) {
+    Serial.print("Temperature: ");
+    printCenti(temperature);
+    Serial.print(" C, Humidity: ");
+    printCenti(humidity);
+    Serial.println(" %rH");
+  }
+  delay(500);
+}
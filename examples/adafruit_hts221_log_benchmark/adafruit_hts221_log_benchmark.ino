@@ -0,0 +1,85 @@
+// Logs live samples in the compact binary format and reports the bytes per
+// sample and the time taken to encode each one. The log is decoded again at
+// the end to check it round trips exactly.
+
+#include <Adafruit_HTS221.h>
+#include <Adafruit_HTS221_Log.h>
+
+#define SAMPLE_COUNT 64
+
+Adafruit_HTS221 hts;
+hts221_calibration_t calibration;
+
+uint8_t log_buffer[HTS221_LOG_MAX_HEADER +
+                   SAMPLE_COUNT * HTS221_LOG_MAX_RECORD];
+Adafruit_HTS221_LogEncoder encoder(log_buffer, sizeof(log_buffer));
+hts221_raw_sample_t samples[SAMPLE_COUNT];
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 log benchmark");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  hts.getCalibration(&calibration);
+
+  // collect the samples first so only the encoding is timed
+  hts221_raw_record_t record;
+  uint16_t count = 0;
+  while (count < SAMPLE_COUNT) {
+    if (hts.readBatch(&record, 1)) {
+      samples[count].timestamp_us = micros();
+      samples[count].temperature = record.temperature;
+      samples[count].humidity = record.humidity;
+      count++;
+    }
+    delay(10);
+  }
+
+  encoder.begin(&calibration);
+  size_t header_length = encoder.length();
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    encoder.add(&samples[i]);
+  }
+  uint32_t elapsed_us = micros() - start;
+
+  Serial.print("Header: ");
+  Serial.print(header_length);
+  Serial.println(" bytes");
+  Serial.print("Bytes per sample: ");
+  Serial.println((float)(encoder.length() - header_length) / SAMPLE_COUNT);
+  Serial.print("Encode: ");
+  Serial.print((float)elapsed_us / SAMPLE_COUNT);
+  Serial.println(" us per sample");
+  Serial.print("As float events: ");
+  Serial.print(2 * sizeof(sensors_event_t));
+  Serial.println(" bytes per sample");
+
+  Adafruit_HTS221_LogDecoder decoder;
+  if (!decoder.begin(encoder.data(), encoder.length())) {
+    Serial.println("Log header didn't decode");
+    return;
+  }
+  hts221_raw_sample_t sample;
+  uint16_t matched = 0;
+  for (uint16_t i = 0; decoder.next(&sample) && i < SAMPLE_COUNT; i++) {
+    if (sample.temperature == samples[i].temperature &&
+        sample.humidity == samples[i].humidity) {
+      matched++;
+    }
+  }
+  Serial.print("Decoded samples matching: ");
+  Serial.print(matched);
+  Serial.print(" of ");
+  Serial.println(SAMPLE_COUNT);
+}
+
+void loop() { delay(1000); }
@@ -0,0 +1,99 @@
+// Times the table based dew point and absolute humidity against the same
+// Magnus formula evaluated with logf/expf, reports the largest difference
+// between them, then prints the derived metrics for live readings
+
+#include <Adafruit_HTS221.h>
+#include <Adafruit_HTS221_Psychro.h>
+
+#define SAMPLE_COUNT 128
+
+Adafruit_HTS221 hts;
+
+int16_t temperatures[SAMPLE_COUNT];
+int16_t humidities[SAMPLE_COUNT];
+int16_t dew_points[SAMPLE_COUNT];
+float reference[SAMPLE_COUNT];
+
+float magnusDewPoint(float temperature, float humidity) {
+  float gamma = logf(humidity / 100) + 17.62f * temperature /
+                                           (243.12f + temperature);
+  return 243.12f * gamma / (17.62f - gamma);
+}
+
+void report(const char *name, uint32_t elapsed_us) {
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((float)elapsed_us / SAMPLE_COUNT);
+  Serial.println(" us per sample");
+}
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 psychrometrics benchmark");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+
+  // a spread of readings across the sensor's range
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    temperatures[i] = (int16_t)(i * 125 - 4000);
+    humidities[i] = (int16_t)(100 + (i * 773) % 9900);
+  }
+
+  uint32_t start = micros();
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    dew_points[i] = hts221_dewPointCenti(temperatures[i], humidities[i]);
+  }
+  report("Dew point, tables", micros() - start);
+
+  start = micros();
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    reference[i] =
+        magnusDewPoint(temperatures[i] / 100.0f, humidities[i] / 100.0f);
+  }
+  report("Dew point, logf", micros() - start);
+
+  float max_error = 0;
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    float error = fabsf(dew_points[i] / 100.0f - reference[i]);
+    if (error > max_error) {
+      max_error = error;
+    }
+  }
+  Serial.print("Largest dew point difference: ");
+  Serial.print(max_error, 3);
+  Serial.println(" C");
+
+  hts221_psychro_t metrics;
+  start = micros();
+  for (uint16_t i = 0; i < SAMPLE_COUNT; i++) {
+    hts221_psychrometrics(temperatures[i], humidities[i], &metrics);
+  }
+  report("All metrics", micros() - start);
+}
+
+void loop() {
+  sensors_event_t temp;
+  sensors_event_t humidity;
+  if (!hts.getEvent(&humidity, &temp)) {
+    delay(10); // no sample yet
+    return;
+  }
+
+  Serial.print("Dew point: ");
+  Serial.print(hts221_dewPoint(temp.temperature, humidity.relative_humidity));
+  Serial.print(" C, absolute humidity: ");
+  Serial.print(hts221_absoluteHumidity(temp.temperature,
+                                       humidity.relative_humidity));
+  Serial.print(" g/m^3, heat index: ");
+  Serial.print(hts221_heatIndex(temp.temperature, humidity.relative_humidity));
+  Serial.println(" C");
+  delay(1000);
+}
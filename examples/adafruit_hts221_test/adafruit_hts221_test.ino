@@ -41,7 +41,12 @@ void loop() {
 
   sensors_event_t temp;
   sensors_event_t humidity;
-  hts.getEvent(&humidity, &temp);// populate temp and humidity objects with fresh data
+  // populate temp and humidity objects with fresh data; this fails until the
+  // sensor has finished its first conversion
+  if (!hts.getEvent(&humidity, &temp)) {
+    delay(10);
+    return;
+  }
   Serial.print("Temperature: "); Serial.print(temp.temperature); Serial.println(" degrees C");
   Serial.print("Humidity: "); Serial.print(humidity.relative_humidity); Serial.println("% rH");
 
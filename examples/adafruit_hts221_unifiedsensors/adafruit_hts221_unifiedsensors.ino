@@ -31,8 +31,10 @@ void loop() {
   //  /* Get a new normalized sensor event */
   sensors_event_t humidity;
   sensors_event_t temp;
-  hts_humidity->getEvent(&humidity);
-  hts_temp->getEvent(&temp);
+  if (!hts_humidity->getEvent(&humidity) || !hts_temp->getEvent(&temp)) {
+    delay(10); // no sample yet
+    return;
+  }
 
   Serial.print("\t\tTemperature ");
   Serial.print(temp.temperature);
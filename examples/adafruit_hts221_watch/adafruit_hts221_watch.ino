@@ -0,0 +1,52 @@
+// Only reports when the temperature crosses 25 C, the humidity crosses
+// 60 %RH, or either moves by more than its deadband. The checks run on the
+// raw counts, so samples with nothing to report are never converted.
+
+#include <Adafruit_HTS221.h>
+
+Adafruit_HTS221 hts;
+
+void setup(void) {
+  Serial.begin(115200);
+  while (!Serial)
+    delay(10); // will pause Zero, Leonardo, etc until serial console opens
+
+  Serial.println("Adafruit HTS221 watch test");
+
+  if (!hts.begin_I2C()) {
+    Serial.println("Failed to find HTS221 chip");
+    while (1) {
+      delay(10);
+    }
+  }
+  hts.setDataRate(HTS221_RATE_12_5_HZ);
+
+  hts221_watch_t watch;
+  watch.temp_threshold = 25.0;
+  watch.humidity_threshold = 60.0;
+  watch.temp_deadband = 0.5;
+  watch.humidity_deadband = 2.0;
+  watch.enable = HTS221_WATCH_TEMP_CROSSED | HTS221_WATCH_HUMIDITY_CROSSED |
+                 HTS221_WATCH_TEMP_MOVED | HTS221_WATCH_HUMIDITY_MOVED;
+  hts.setWatch(&watch);
+}
+
+void loop() {
+  sensors_event_t temp;
+  sensors_event_t humidity;
+  uint8_t events = hts.checkWatch(&humidity, &temp);
+  if (events) {
+    if (events & HTS221_WATCH_TEMP_CROSSED) {
+      Serial.print("Crossed 25 C: ");
+    } else if (events & HTS221_WATCH_HUMIDITY_CROSSED) {
+      Serial.print("Crossed 60 %RH: ");
+    } else {
+      Serial.print("Changed: ");
+    }
+    Serial.print(temp.temperature);
+    Serial.print(" C, ");
+    Serial.print(humidity.relative_humidity);
+    Serial.println(" %RH");
+  }
+  delay(20);
+}
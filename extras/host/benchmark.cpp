@@ -0,0 +1,301 @@
+/*!
+ *  @file benchmark.cpp
+ *
+ * 	Measures what each Adafruit HTS221 library call costs: I2C transactions,
+ * 	bytes on the wire, simulated bus time at 100 kHz, simulated time the
+ * 	call takes including any waits, and host time. Bus numbers are exact
+ * 	for the driver as built; host times are for this machine, not a board,
+ * 	and are only useful for comparing calls and revisions. A second table
+ * 	times the bulk conversion kernels against converting one sample at a
+ * 	time with the float divide the driver used before them.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_HTS221.h>
+#include <Adafruit_HTS221_Group.h>
+#include <Adafruit_HTS221_Lite.h>
+#include <stdio.h>
+#include <time.h>
+
+#define ITERATIONS 200       ///< Calls averaged for each row
+#define CONVERT_SAMPLES 4096 ///< Samples in each conversion pass
+#define CONVERT_PASSES 500   ///< Passes timed for each conversion row
+
+static HTS221_Sim sim;
+static Adafruit_HTS221 hts;
+static sensors_event_t temp_event, humidity_event;
+static int16_t centi_temp, centi_humidity;
+static hts221_raw_record_t records[8];
+static uint64_t overhead_ns = 0;
+
+typedef void (*step_t)(void);
+
+// one fresh sensor on Wire, running the driver's defaults
+static void attachOne(void) {
+  sim_reset();
+  sim.powerOn();
+  sim_attach(&sim);
+}
+
+static uint64_t hostNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void nothing(void) {}
+
+/*!
+ *    @brief  Runs a call ITERATIONS times and prints its average cost
+ *    @param  name The row label
+ *    @param  setup Run before each call and not counted, or NULL
+ *    @param  call The call to measure
+ */
+static void measure(const char *name, step_t setup, step_t call) {
+  uint64_t transactions = 0, bytes = 0, bus_us = 0, elapsed_us = 0;
+  uint64_t host_ns = 0;
+  for (uint16_t i = 0; i < ITERATIONS; i++) {
+    if (setup) {
+      setup();
+    }
+    sim_counters_t before = sim_counters;
+    uint64_t start_us = sim_now();
+    uint64_t start_ns = hostNs();
+    call();
+    host_ns += hostNs() - start_ns;
+    elapsed_us += sim_now() - start_us;
+    transactions += sim_counters.transactions - before.transactions;
+    bytes += sim_counters.bytes - before.bytes;
+    bus_us += sim_counters.bus_us - before.bus_us;
+  }
+  host_ns /= ITERATIONS;
+  host_ns = (host_ns > overhead_ns) ? host_ns - overhead_ns : 0;
+  printf("%-38s %6.1f %7.1f %9.0f %10.0f %9llu\n", name,
+         (double)transactions / ITERATIONS, (double)bytes / ITERATIONS,
+         (double)bus_us / ITERATIONS, (double)elapsed_us / ITERATIONS,
+         (unsigned long long)host_ns);
+}
+
+static void beginI2C(void) { hts.begin_I2C(); }
+
+static void beginNonBlocking(void) {
+  hts.startBegin_I2C();
+  while (hts.pollBegin() == HTS221_BEGIN_BUSY) {
+    delay(1);
+  }
+}
+
+static void begun(void) {
+  attachOne();
+  hts.begin_I2C();
+}
+
+static void newSample(void) { delay(100); }
+
+static void readNewSample(void) {
+  delay(100);
+  hts.getEvent(&humidity_event, &temp_event);
+}
+
+static void getEvent(void) { hts.getEvent(&humidity_event, &temp_event); }
+
+static void unifiedPair(void) {
+  hts.getTemperatureSensor()->getEvent(&temp_event);
+  hts.getHumiditySensor()->getEvent(&humidity_event);
+}
+
+static void readCenti(void) { hts.readCenti(&centi_temp, &centi_humidity); }
+
+static void begunAndRead(void) {
+  begun();
+  readNewSample();
+}
+
+static void oneShotMode(void) {
+  begun();
+  hts.setDataRate(HTS221_RATE_ONE_SHOT);
+}
+
+static void oneShotCycle(void) {
+  hts.startOneShot();
+  while (!hts.pollOneShot()) {
+    delay(1);
+  }
+  hts.readCenti(&centi_temp, &centi_humidity);
+}
+
+static void splitPhase(void) {
+  hts221_reading_t reading;
+  hts.requestSample();
+  while (hts.pollSample(&reading) == HTS221_SAMPLE_BUSY) {
+    delay(1);
+  }
+}
+
+static void readBatch(void) { hts.readBatch(records, 8); }
+
+static void setDataRate(void) { hts.setDataRate(HTS221_RATE_7_HZ); }
+
+static void configure(void) {
+  hts221_config_t config;
+  hts.getConfig(&config);
+  config.heater = !config.heater;
+  hts.configure(&config);
+}
+
+static void watched(void) {
+  readNewSample();
+  hts221_watch_t watch = {25.0, 50.0, 0.5, 1.0, 0x0F};
+  hts.setWatch(&watch);
+}
+
+static void checkWatch(void) { hts.checkWatch(); }
+
+static Adafruit_HTS221_Lite<Adafruit_HTS221_LiteI2C<> > lite;
+
+static void liteBegin(void) { lite.begin(); }
+
+static void liteBegun(void) {
+  attachOne();
+  lite.begin();
+  delay(100);
+}
+
+static void liteReadCenti(void) {
+  lite.readCenti(&centi_temp, &centi_humidity);
+}
+
+#define GROUP_SIZE 4 ///< Sensors in the group benchmark
+static HTS221_Sim group_sims[GROUP_SIZE];
+static Adafruit_HTS221 group_sensors[GROUP_SIZE];
+static hts221_group_member_t group_members[GROUP_SIZE];
+static hts221_group_reading_t group_readings[GROUP_SIZE];
+static Adafruit_HTS221_Group group(group_members, group_readings, GROUP_SIZE);
+
+static void groupBegun(void) {
+  sim_reset();
+  // a fresh, empty group each time
+  group = Adafruit_HTS221_Group(group_members, group_readings, GROUP_SIZE);
+  for (uint8_t i = 0; i < GROUP_SIZE; i++) {
+    group_sims[i].powerOn();
+    sim_attach(&group_sims[i], &Wire, 0x70, i);
+    group.add(&group_sensors[i], &Wire, 0x70, i);
+  }
+  group.begin();
+}
+
+static void groupRead(void) {
+  hts221_group_snapshot_t snapshot;
+  group.read(&snapshot);
+}
+
+static int16_t convert_raw[CONVERT_SAMPLES];
+static hts221_raw_record_t convert_records[CONVERT_SAMPLES];
+static float convert_float[CONVERT_SAMPLES];
+static int16_t convert_centi[CONVERT_SAMPLES];
+static hts221_calibration_t convert_cal;
+
+// one sample at a time, evaluating the calibration line with a float divide
+// the way the driver did before the fixed-point coefficients
+static void scalarDivide(void) {
+  int16_t t0 = (int16_t)convert_cal.t0_degc;
+  int16_t t1 = (int16_t)convert_cal.t1_degc;
+  int16_t t0_out = (int16_t)convert_cal.t0_out;
+  int16_t t1_out = (int16_t)convert_cal.t1_out;
+  for (uint16_t i = 0; i < CONVERT_SAMPLES; i++) {
+    convert_float[i] = (float)(convert_raw[i] - t0_out) * (float)(t1 - t0) /
+                           (float)(t1_out - t0_out) +
+                       t0;
+  }
+}
+
+static void kernelFloat(void) {
+  hts221_convertTemperatures(hts.getCoefficients(), convert_raw,
+                             convert_float, CONVERT_SAMPLES);
+}
+
+static void kernelCenti(void) {
+  hts221_convertTemperaturesCenti(hts.getCoefficients(), convert_raw,
+                                  convert_centi, CONVERT_SAMPLES);
+}
+
+static void batchCenti(void) {
+  hts.convertBatch(convert_records, CONVERT_SAMPLES, convert_centi,
+                   convert_centi);
+}
+
+/*!
+ *    @brief  Times CONVERT_PASSES passes of a conversion over
+ *            CONVERT_SAMPLES samples and prints the samples per second
+ *    @param  name The row label
+ *    @param  pass The conversion pass to time
+ */
+static void throughput(const char *name, step_t pass) {
+  pass(); // warms the caches
+  uint64_t start_ns = hostNs();
+  for (uint16_t i = 0; i < CONVERT_PASSES; i++) {
+    pass();
+    // keeps the compiler from dropping passes that store the same results
+    __asm__ __volatile__("" ::: "memory");
+  }
+  uint64_t ns = hostNs() - start_ns;
+  printf("%-38s %14.0f\n", name,
+         (double)CONVERT_SAMPLES * CONVERT_PASSES * 1e9 / (double)ns);
+}
+
+int main(void) {
+  // what reading the clock itself costs, taken off every row
+  overhead_ns = UINT64_MAX;
+  for (uint16_t i = 0; i < 1000; i++) {
+    uint64_t start_ns = hostNs();
+    nothing();
+    uint64_t ns = hostNs() - start_ns;
+    if (ns < overhead_ns) {
+      overhead_ns = ns;
+    }
+  }
+
+  printf("I2C at %lu kHz, averages of %d calls\n\n",
+         (unsigned long)(sim_bus_hz / 1000), ITERATIONS);
+  printf("%-38s %6s %7s %9s %10s %9s\n", "call", "trans", "bytes", "bus us",
+         "elapsed us", "host ns");
+
+  measure("begin_I2C() after power on", attachOne, beginI2C);
+  measure("begin_I2C() again", NULL, beginI2C);
+  measure("startBegin_I2C() + pollBegin()", attachOne, beginNonBlocking);
+  measure("getEvent(), new sample", newSample, getEvent);
+  measure("getEvent(), same sample", readNewSample, getEvent);
+  measure("unified temp + humidity getEvent()", newSample, unifiedPair);
+  measure("readCenti(), new sample", newSample, readCenti);
+  measure("readCenti(), same sample", readNewSample, readCenti);
+  measure("readBatch(), new sample", newSample, readBatch);
+  measure("requestSample() to READY, new sample", newSample, splitPhase);
+  measure("one shot start, poll, readCenti()", oneShotMode, oneShotCycle);
+  measure("requestSample() to READY, one shot", oneShotMode, splitPhase);
+  measure("requestSample() to READY, same sample", begunAndRead, splitPhase);
+  measure("setDataRate(), changed", begun, setDataRate);
+  measure("configure(), heater toggled", NULL, configure);
+  measure("checkWatch(), same sample", watched, checkWatch);
+  measure("Lite begin()", attachOne, liteBegin);
+  measure("Lite readCenti()", liteBegun, liteReadCenti);
+  measure("Group read(), 4 sensors on a mux", groupBegun, groupRead);
+
+  // a spread of raw readings around room temperature. This host divides
+  // floats in hardware and vectorizes the scalar loop too, so the gap is
+  // nothing like a board without an FPU
+  begun();
+  hts.getCalibration(&convert_cal);
+  for (uint16_t i = 0; i < CONVERT_SAMPLES; i++) {
+    convert_raw[i] = (int16_t)((i % 512) * 8 - 2048);
+    convert_records[i].temperature = convert_raw[i];
+    convert_records[i].humidity = (int16_t)((i % 512) * 16 - 4096);
+  }
+  printf("\n%-38s %14s\n", "temperature conversion", "samples/s");
+  throughput("scalar float divide", scalarDivide);
+  throughput("hts221_convertTemperatures()", kernelFloat);
+  throughput("hts221_convertTemperaturesCenti()", kernelCenti);
+  throughput("convertBatch(), centi, both channels", batchCenti);
+  return 0;
+}
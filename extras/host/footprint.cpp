@@ -0,0 +1,39 @@
+/*!
+ *  @file footprint.cpp
+ *
+ * 	A minimal sketch, built three ways by `make size` to compare how much
+ * 	code each driver pulls in: FOOTPRINT 0 reads a register with Wire, so
+ * 	the simulated bus is in every build, 1 begins and reads with the full
+ * 	driver, and 2 does the same with the Lite driver.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#if FOOTPRINT == 1
+#include <Adafruit_HTS221.h>
+Adafruit_HTS221 hts;
+#elif FOOTPRINT == 2
+#include <Adafruit_HTS221_Lite.h>
+Adafruit_HTS221_Lite<Adafruit_HTS221_LiteI2C<> > hts;
+#endif
+
+int main(void) {
+  int16_t temperature = 0, humidity = 0;
+#if FOOTPRINT == 1
+  if (!hts.begin_I2C() || !hts.readCenti(&temperature, &humidity)) {
+    return 1;
+  }
+#elif FOOTPRINT == 2
+  if (!hts.begin() || !hts.readCenti(&temperature, &humidity)) {
+    return 1;
+  }
+#else
+  Wire.beginTransmission(SIM_HTS221_ADDRESS);
+  Wire.write(0x0F);
+  Wire.endTransmission(false);
+  Wire.requestFrom(SIM_HTS221_ADDRESS, 1);
+  temperature = Wire.read();
+#endif
+  return temperature + humidity;
+}
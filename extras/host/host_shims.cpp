@@ -0,0 +1,385 @@
+/*!
+ *  @file host_shims.cpp
+ *
+ * 	Host implementations of the Arduino core and Adafruit BusIO calls the
+ * 	HTS221 library makes. The BusIO classes make the same Wire calls as the
+ * 	real ones, so the simulated bus counts the same transactions a board
+ * 	would make.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_BusIO_Register.h>
+#include <Adafruit_I2CDevice.h>
+#include <Adafruit_SPIDevice.h>
+#include <SPI.h>
+
+SPIClass SPI;
+
+/*!
+ *    @brief  Gets the simulated time
+ *    @return Milliseconds since `sim_reset()`
+ */
+unsigned long millis(void) { return (unsigned long)(sim_now() / 1000); }
+
+/*!
+ *    @brief  Gets the simulated time
+ *    @return Microseconds since `sim_reset()`, wrapping at 32 bits as on a
+ *            board
+ */
+unsigned long micros(void) { return (uint32_t)sim_now(); }
+
+/*!
+ *    @brief  Moves the simulated clock forward
+ *    @param  ms The number of milliseconds
+ */
+void delay(unsigned long ms) { sim_advance((uint64_t)ms * 1000); }
+
+/*!
+ *    @brief  Moves the simulated clock forward
+ *    @param  us The number of microseconds
+ */
+void delayMicroseconds(unsigned int us) { sim_advance(us); }
+
+/*!
+ *    @brief  Lets a microsecond pass, so polling loops move on
+ */
+void yield(void) { sim_advance(1); }
+
+/*!
+ *    @brief  Sets a pin's mode; there are no pins on the host
+ *    @param  pin The pin
+ *    @param  mode The mode
+ */
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+/*!
+ *    @brief  Sets a pin's level; there are no pins on the host
+ *    @param  pin The pin
+ *    @param  value The level
+ */
+void digitalWrite(uint8_t pin, uint8_t value) {
+  (void)pin;
+  (void)value;
+}
+
+/*!
+ *    @brief  Reads a pin's level; there are no pins on the host
+ *    @param  pin The pin
+ *    @return LOW
+ */
+int digitalRead(uint8_t pin) {
+  (void)pin;
+  return LOW;
+}
+
+/*!
+ *    @brief  Creates a device
+ *    @param  addr The 7-bit address
+ *    @param  theWire The bus
+ */
+Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire)
+    : _addr(addr), _wire(theWire) {}
+
+/*!
+ *    @brief  Gets the device's address
+ *    @return The 7-bit address
+ */
+uint8_t Adafruit_I2CDevice::address(void) { return _addr; }
+
+/*!
+ *    @brief  Starts the bus and optionally checks the device answers
+ *    @param  addr_detect True to check for the device
+ *    @return True if the device was found, or not looked for
+ */
+bool Adafruit_I2CDevice::begin(bool addr_detect) {
+  _wire->begin();
+  _begun = true;
+  if (addr_detect) {
+    return detected();
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Marks the device as no longer in use
+ */
+void Adafruit_I2CDevice::end(void) { _begun = false; }
+
+/*!
+ *    @brief  Checks the device answers with an empty write
+ *    @return True if the address was acknowledged
+ */
+bool Adafruit_I2CDevice::detected(void) {
+  if (!_begun && !begin(false)) {
+    return false;
+  }
+  _wire->beginTransmission(_addr);
+  return _wire->endTransmission() == 0;
+}
+
+/*!
+ *    @brief  Writes to the device, with an optional prefix such as a
+ *            register address
+ *    @param  buffer The bytes to write
+ *    @param  len The number of bytes
+ *    @param  stop False to follow with a repeated start
+ *    @param  prefix_buffer Bytes to write first, or NULL
+ *    @param  prefix_len The number of prefix bytes
+ *    @return True if the write was acknowledged
+ */
+bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  if (len + prefix_len > maxBufferSize()) {
+    return false;
+  }
+  _wire->beginTransmission(_addr);
+  if (prefix_len && _wire->write(prefix_buffer, prefix_len) != prefix_len) {
+    return false;
+  }
+  if (_wire->write(buffer, len) != len) {
+    return false;
+  }
+  return _wire->endTransmission(stop) == 0;
+}
+
+/*!
+ *    @brief  Reads from the device, in chunks of the bus buffer size
+ *    @param  buffer Where to put the bytes
+ *    @param  len The number of bytes
+ *    @param  stop Whether to end with a stop
+ *    @return True if every byte was read
+ */
+bool Adafruit_I2CDevice::read(uint8_t *buffer, size_t len, bool stop) {
+  size_t pos = 0;
+  while (pos < len) {
+    size_t chunk = len - pos;
+    if (chunk > maxBufferSize()) {
+      chunk = maxBufferSize();
+    }
+    bool last = (pos + chunk) >= len;
+    if (!_read(buffer + pos, chunk, last ? stop : false)) {
+      return false;
+    }
+    pos += chunk;
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Writes then reads with a repeated start between, as a register
+ *            read does
+ *    @param  write_buffer The bytes to write
+ *    @param  write_len The number of bytes to write
+ *    @param  read_buffer Where to put the bytes read
+ *    @param  read_len The number of bytes to read
+ *    @param  stop Whether the write ends with a stop
+ *    @return True if both parts succeeded
+ */
+bool Adafruit_I2CDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len, uint8_t *read_buffer,
+                                         size_t read_len, bool stop) {
+  if (!write(write_buffer, write_len, stop)) {
+    return false;
+  }
+  return read(read_buffer, read_len);
+}
+
+/*!
+ *    @brief  Sets the bus clock; the simulated bus runs at `sim_bus_hz`
+ *    @param  desiredclk The clock in Hz
+ *    @return True
+ */
+bool Adafruit_I2CDevice::setSpeed(uint32_t desiredclk) {
+  _wire->setClock(desiredclk);
+  return true;
+}
+
+// reads one chunk that fits in the bus buffer
+bool Adafruit_I2CDevice::_read(uint8_t *buffer, size_t len, bool stop) {
+  size_t recv = _wire->requestFrom(_addr, (uint8_t)len, (uint8_t)stop);
+  if (recv != len) {
+    return false;
+  }
+  for (size_t i = 0; i < len; i++) {
+    buffer[i] = _wire->read();
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Creates a hardware SPI device
+ *    @param  cspin The chip select pin
+ *    @param  freq The clock in Hz
+ *    @param  dataOrder The bit order
+ *    @param  dataMode The SPI mode
+ *    @param  theSPI The bus
+ */
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode, SPIClass *theSPI) {
+  (void)cspin;
+  (void)freq;
+  (void)dataOrder;
+  (void)dataMode;
+  (void)theSPI;
+}
+
+/*!
+ *    @brief  Creates a software SPI device
+ *    @param  cspin The chip select pin
+ *    @param  sck The clock pin
+ *    @param  miso The data in pin
+ *    @param  mosi The data out pin
+ *    @param  freq The clock in Hz
+ *    @param  dataOrder The bit order
+ *    @param  dataMode The SPI mode
+ */
+Adafruit_SPIDevice::Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso,
+                                       int8_t mosi, uint32_t freq,
+                                       BusIOBitOrder dataOrder,
+                                       uint8_t dataMode) {
+  (void)cspin;
+  (void)sck;
+  (void)miso;
+  (void)mosi;
+  (void)freq;
+  (void)dataOrder;
+  (void)dataMode;
+}
+
+/*!
+ *    @brief  Sets up the pins
+ *    @return True
+ */
+bool Adafruit_SPIDevice::begin(void) { return true; }
+
+/*!
+ *    @brief  Reads from the device; nothing is attached over SPI
+ *    @param  buffer Where to put the bytes
+ *    @param  len The number of bytes
+ *    @param  sendvalue The byte clocked out while reading
+ *    @return False
+ */
+bool Adafruit_SPIDevice::read(uint8_t *buffer, size_t len, uint8_t sendvalue) {
+  (void)buffer;
+  (void)len;
+  (void)sendvalue;
+  return false;
+}
+
+/*!
+ *    @brief  Writes to the device; nothing is attached over SPI
+ *    @param  buffer The bytes to write
+ *    @param  len The number of bytes
+ *    @param  prefix_buffer Bytes to write first, or NULL
+ *    @param  prefix_len The number of prefix bytes
+ *    @return False
+ */
+bool Adafruit_SPIDevice::write(const uint8_t *buffer, size_t len,
+                               const uint8_t *prefix_buffer,
+                               size_t prefix_len) {
+  (void)buffer;
+  (void)len;
+  (void)prefix_buffer;
+  (void)prefix_len;
+  return false;
+}
+
+/*!
+ *    @brief  Writes then reads; nothing is attached over SPI
+ *    @param  write_buffer The bytes to write
+ *    @param  write_len The number of bytes to write
+ *    @param  read_buffer Where to put the bytes read
+ *    @param  read_len The number of bytes to read
+ *    @param  sendvalue The byte clocked out while reading
+ *    @return False
+ */
+bool Adafruit_SPIDevice::write_then_read(const uint8_t *write_buffer,
+                                         size_t write_len, uint8_t *read_buffer,
+                                         size_t read_len, uint8_t sendvalue) {
+  (void)write_buffer;
+  (void)write_len;
+  (void)read_buffer;
+  (void)read_len;
+  (void)sendvalue;
+  return false;
+}
+
+/*!
+ *    @brief  Exchanges bytes; nothing is attached over SPI
+ *    @param  buffer The bytes to send, replaced by the bytes received
+ *    @param  len The number of bytes
+ *    @return False
+ */
+bool Adafruit_SPIDevice::write_and_read(uint8_t *buffer, size_t len) {
+  (void)buffer;
+  (void)len;
+  return false;
+}
+
+/*!
+ *    @brief  Creates a register
+ *    @param  i2cdevice The I2C device, or NULL
+ *    @param  spidevice The SPI device, or NULL
+ *    @param  type How the SPI read/write bit is set
+ *    @param  reg_addr The register address
+ *    @param  width The register width in bytes
+ *    @param  byteorder The register byte order
+ *    @param  address_width The address width in bytes
+ */
+Adafruit_BusIO_Register::Adafruit_BusIO_Register(
+    Adafruit_I2CDevice *i2cdevice, Adafruit_SPIDevice *spidevice,
+    Adafruit_BusIO_SPIRegType type, uint16_t reg_addr, uint8_t width,
+    uint8_t byteorder, uint8_t address_width)
+    : _i2cdevice(i2cdevice), _spidevice(spidevice), _spiregtype(type),
+      _address(reg_addr) {
+  (void)width;
+  (void)byteorder;
+  (void)address_width;
+}
+
+/*!
+ *    @brief  Reads consecutive bytes starting at the register
+ *    @param  buffer Where to put the bytes
+ *    @param  len The number of bytes
+ *    @return True if the read succeeded
+ */
+bool Adafruit_BusIO_Register::read(uint8_t *buffer, uint8_t len) {
+  uint8_t addr = _address & 0xFF;
+  if (_i2cdevice) {
+    return _i2cdevice->write_then_read(&addr, 1, buffer, len);
+  }
+  if (_spidevice) {
+    if (_spiregtype == ADDRBIT8_HIGH_TOREAD) {
+      addr |= 0x80;
+    }
+    return _spidevice->write_then_read(&addr, 1, buffer, len);
+  }
+  return false;
+}
+
+/*!
+ *    @brief  Writes consecutive bytes starting at the register
+ *    @param  buffer The bytes to write
+ *    @param  len The number of bytes
+ *    @return True if the write succeeded
+ */
+bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  uint8_t addr = _address & 0xFF;
+  if (_i2cdevice) {
+    return _i2cdevice->write(buffer, len, true, &addr, 1);
+  }
+  if (_spidevice) {
+    if (_spiregtype == ADDRBIT8_HIGH_TOREAD) {
+      addr &= ~0x80;
+    }
+    return _spidevice->write(buffer, len, &addr, 1);
+  }
+  return false;
+}
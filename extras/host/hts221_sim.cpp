@@ -0,0 +1,460 @@
+/*!
+ *  @file hts221_sim.cpp
+ *
+ * 	A simulated HTS221 register model and I2C bus for building and measuring
+ * 	the Adafruit HTS221 library on a host.
+ *
+ * 	The register model covers what the driver relies on: WHO_AM_I, AV_CONF,
+ * 	the control registers, STATUS_REG data ready bits that clear when the
+ * 	output high bytes are read, the 0x30-0x3F calibration block, sub-address
+ * 	auto-increment, BOOT timing, and continuous and one shot conversions.
+ * 	Transfers are atomic, so block data update has nothing to protect.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+
+#define REG_WHO_AM_I 0x0F
+#define REG_AV_CONF 0x10
+#define REG_CTRL_1 0x20
+#define REG_CTRL_2 0x21
+#define REG_STATUS 0x27
+#define REG_HUMIDITY_OUT_H 0x29
+#define REG_TEMP_OUT_H 0x2B
+#define REG_CALIBRATION 0x30
+#define AUTO_INCREMENT 0x80
+
+sim_counters_t sim_counters;
+uint32_t sim_bus_hz = 100000;
+uint32_t sim_latency_us = 0;
+bool sim_bus_fail = false;
+
+// a calibration block read from a real part: about 28.1 C and 57.6 %RH at
+// the default outputs
+static const uint8_t _calibration[16] = {0x34, 0x83, 0xA8, 0x3A, 0x00, 0x04,
+                                         0x30, 0xF8, 0x00, 0x00, 0x40, 0x1F,
+                                         0x00, 0xFF, 0x80, 0x04};
+
+// where each attached sensor is
+typedef struct {
+  HTS221_Sim *sensor;
+  TwoWire *wire;
+  uint8_t mux_address;
+  uint8_t mux_channel;
+} attachment_t;
+
+typedef struct {
+  TwoWire *wire;
+  uint8_t address;
+  uint8_t channels; // enabled channel bits
+} mux_t;
+
+static uint64_t _now_us = 0;
+static attachment_t _sensors[SIM_MAX_SENSORS];
+static uint8_t _sensor_count = 0;
+static mux_t _muxes[SIM_MAX_MUXES];
+static uint8_t _mux_count = 0;
+
+/*!
+ *    @brief  Creates a powered up sensor
+ */
+HTS221_Sim::HTS221_Sim(void) { powerOn(); }
+
+/*!
+ *    @brief  Puts every register back to its power on value
+ */
+void HTS221_Sim::powerOn(void) {
+  memset(_regs, 0, sizeof(_regs));
+  _regs[REG_WHO_AM_I] = 0xBC;
+  _regs[REG_AV_CONF] = 0x1B;
+  memcpy(&_regs[REG_CALIBRATION], _calibration, sizeof(_calibration));
+  _temperature = 300;
+  _humidity = 6000;
+  _now_us = sim_now();
+  _boot_done_us = 0;
+  _next_sample_us = 0;
+  _one_shot_done_us = 0;
+  conversions = 0;
+}
+
+/*!
+ *    @brief  Sets the raw outputs the following conversions produce
+ *    @param  temperature The TEMP_OUT value
+ *    @param  humidity The HUMIDITY_OUT value
+ */
+void HTS221_Sim::setOutputs(int16_t temperature, int16_t humidity) {
+  _temperature = temperature;
+  _humidity = humidity;
+}
+
+/*!
+ *    @brief  Reads a register the way the bus does, clearing the data ready
+ *            bits when the output high bytes are read
+ *    @param  reg The register address, without the auto-increment bit
+ *    @return The register value
+ */
+uint8_t HTS221_Sim::readRegister(uint8_t reg) {
+  if (reg >= sizeof(_regs)) {
+    return 0;
+  }
+  uint8_t value = _regs[reg];
+  if (reg == REG_HUMIDITY_OUT_H) {
+    _regs[REG_STATUS] &= ~0x02;
+  } else if (reg == REG_TEMP_OUT_H) {
+    _regs[REG_STATUS] &= ~0x01;
+  }
+  return value;
+}
+
+/*!
+ *    @brief  Writes a register the way the bus does, starting a boot, a one
+ *            shot or continuous conversions as the value asks
+ *    @param  reg The register address, without the auto-increment bit
+ *    @param  value The value written
+ */
+void HTS221_Sim::writeRegister(uint8_t reg, uint8_t value) {
+  // only the configuration registers are writable
+  if (reg != REG_AV_CONF && (reg < REG_CTRL_1 || reg > REG_CTRL_1 + 2)) {
+    return;
+  }
+  uint8_t old = _regs[reg];
+  _regs[reg] = value;
+
+  if (reg == REG_CTRL_1) {
+    bool running = (value & 0x80) && (value & 0x03);
+    bool was_running = (old & 0x80) && (old & 0x03);
+    if (!running) {
+      _next_sample_us = 0;
+    } else if (!was_running || (old & 0x03) != (value & 0x03)) {
+      _next_sample_us = 0;
+      update(_now_us); // schedules the first sample
+    }
+  } else if (reg == REG_CTRL_2) {
+    if ((value & 0x80) && !_boot_done_us) {
+      _boot_done_us = _now_us + SIM_BOOT_US;
+    }
+    if ((value & 0x01) && (_regs[REG_CTRL_1] & 0x80) &&
+        !(_regs[REG_CTRL_1] & 0x03) && !_one_shot_done_us) {
+      _one_shot_done_us = _now_us + SIM_ONE_SHOT_US;
+    }
+  }
+}
+
+/*!
+ *    @brief  Runs the sensor up to a point in time
+ *    @param  now_us The simulated time in microseconds
+ */
+void HTS221_Sim::update(uint64_t now_us) {
+  _now_us = now_us;
+  if (_boot_done_us && now_us >= _boot_done_us && !stuck_boot) {
+    _regs[REG_CTRL_2] &= ~0x80;
+    _boot_done_us = 0;
+  }
+
+  if (_one_shot_done_us && now_us >= _one_shot_done_us) {
+    _convert();
+    _regs[REG_CTRL_2] &= ~0x01;
+    _one_shot_done_us = 0;
+  }
+
+  uint8_t ctrl_1 = _regs[REG_CTRL_1];
+  if (!(ctrl_1 & 0x80) || !(ctrl_1 & 0x03)) {
+    return;
+  }
+  static const uint32_t periods_us[4] = {0, 1000000, 142857, 80000};
+  uint32_t period_us = periods_us[ctrl_1 & 0x03];
+  if (!_next_sample_us) {
+    _next_sample_us = now_us + period_us;
+  }
+  // only the latest of several missed samples is left in the outputs
+  if (now_us >= _next_sample_us) {
+    _convert();
+    _next_sample_us += ((now_us - _next_sample_us) / period_us + 1) * period_us;
+  }
+}
+
+// latches the next sample into the output registers
+void HTS221_Sim::_convert(void) {
+  _regs[0x28] = (uint8_t)_humidity;
+  _regs[0x29] = (uint8_t)((uint16_t)_humidity >> 8);
+  _regs[0x2A] = (uint8_t)_temperature;
+  _regs[0x2B] = (uint8_t)((uint16_t)_temperature >> 8);
+  _regs[REG_STATUS] |= 0x03;
+  conversions++;
+}
+
+/*!
+ *    @brief  Detaches every sensor and mux and zeroes the clock, the
+ *            counters and the bus settings
+ */
+void sim_reset(void) {
+  _now_us = 0;
+  _sensor_count = 0;
+  _mux_count = 0;
+  memset(&sim_counters, 0, sizeof(sim_counters));
+  sim_bus_hz = 100000;
+  sim_latency_us = 0;
+  sim_bus_fail = false;
+}
+
+/*!
+ *    @brief  Puts a sensor on a bus, and creates its mux if it is the first
+ *            sensor behind it. Muxes start with every channel off
+ *    @param  sensor The sensor
+ *    @param  wire The bus the sensor, or its mux, is on
+ *    @param  mux_address The mux's address, or SIM_NO_MUX
+ *    @param  mux_channel The mux channel, 0-7
+ *    @return True if there was room
+ */
+bool sim_attach(HTS221_Sim *sensor, TwoWire *wire, uint8_t mux_address,
+                uint8_t mux_channel) {
+  if (_sensor_count == SIM_MAX_SENSORS) {
+    return false;
+  }
+  if (mux_address != SIM_NO_MUX) {
+    uint8_t i = 0;
+    while (i < _mux_count &&
+           (_muxes[i].wire != wire || _muxes[i].address != mux_address)) {
+      i++;
+    }
+    if (i == _mux_count) {
+      if (_mux_count == SIM_MAX_MUXES) {
+        return false;
+      }
+      _muxes[i].wire = wire;
+      _muxes[i].address = mux_address;
+      _muxes[i].channels = 0;
+      _mux_count++;
+    }
+  }
+  attachment_t *attachment = &_sensors[_sensor_count++];
+  attachment->sensor = sensor;
+  attachment->wire = wire;
+  attachment->mux_address = mux_address;
+  attachment->mux_channel = mux_channel;
+  sensor->update(_now_us);
+  return true;
+}
+
+/*!
+ *    @brief  Gets the simulated time
+ *    @return Microseconds since `sim_reset()`
+ */
+uint64_t sim_now(void) { return _now_us; }
+
+/*!
+ *    @brief  Moves the simulated clock forward
+ *    @param  us The number of microseconds
+ */
+void sim_advance(uint64_t us) { _now_us += us; }
+
+// finds a mux by its bus and address
+static mux_t *_findMux(TwoWire *wire, uint8_t address) {
+  for (uint8_t i = 0; i < _mux_count; i++) {
+    if (_muxes[i].wire == wire && _muxes[i].address == address) {
+      return &_muxes[i];
+    }
+  }
+  return NULL;
+}
+
+// whether the muxes connect a sensor to its bus right now
+static bool _connected(const attachment_t *attachment) {
+  if (attachment->mux_address == SIM_NO_MUX) {
+    return true;
+  }
+  mux_t *mux = _findMux(attachment->wire, attachment->mux_address);
+  return mux->channels & (1 << attachment->mux_channel);
+}
+
+/*!
+ *    @brief  Makes one I2C transfer: an optional write of `tx`, then an
+ *            optional read into `rx` after a repeated start. It is counted
+ *            as one transaction and takes as long as it would at
+ *            `sim_bus_hz`, plus `sim_latency_us`
+ *    @param  wire The bus
+ *    @param  address The 7-bit device address
+ *    @param  tx The bytes to write; the first is the register sub-address
+ *    @param  tx_len The number of bytes to write
+ *    @param  rx Where to put the bytes read
+ *    @param  rx_len The number of bytes to read
+ *    @return 0 on success, or 2 if no device acknowledged, as
+ *            `endTransmission()` does. A collision between two sensors
+ *            corrupts the data but isn't reported to the master
+ */
+uint8_t sim_transfer(TwoWire *wire, uint8_t address, const uint8_t *tx,
+                     uint8_t tx_len, uint8_t *rx, uint8_t rx_len) {
+  // each byte is 9 clocks with the ACK; a read after a write needs a
+  // repeated start and the address again
+  uint32_t frames = 1 + tx_len + rx_len + (tx_len && rx_len ? 1 : 0);
+  uint64_t bus_us = (frames * 9 * 1000000ULL + sim_bus_hz - 1) / sim_bus_hz;
+  bus_us += sim_latency_us;
+  sim_counters.transactions++;
+  sim_counters.bytes += tx_len + rx_len;
+  sim_counters.bus_us += bus_us;
+  _now_us += bus_us;
+
+  if (sim_bus_fail) {
+    sim_counters.nacks++;
+    for (uint8_t n = 0; n < rx_len; n++) {
+      rx[n] = 0xFF;
+    }
+    return 2;
+  }
+
+  mux_t *mux = _findMux(wire, address);
+  if (mux) {
+    if (tx_len) {
+      mux->channels = tx[tx_len - 1];
+      sim_counters.mux_writes++;
+    }
+    for (uint8_t i = 0; i < rx_len; i++) {
+      rx[i] = mux->channels;
+    }
+    return 0;
+  }
+
+  uint8_t answered = 0;
+  for (uint8_t i = 0; i < _sensor_count; i++) {
+    attachment_t *attachment = &_sensors[i];
+    if (attachment->wire != wire || address != SIM_HTS221_ADDRESS ||
+        !_connected(attachment)) {
+      continue;
+    }
+    HTS221_Sim *sensor = attachment->sensor;
+    if (sensor->ignore_next) {
+      sensor->ignore_next--;
+      continue;
+    }
+    sensor->update(_now_us);
+    uint8_t reg = tx_len ? (tx[0] & ~AUTO_INCREMENT) : 0;
+    bool increment = tx_len && (tx[0] & AUTO_INCREMENT);
+    for (uint8_t n = 1; n < tx_len; n++) {
+      sensor->writeRegister(reg, tx[n]);
+      reg += increment;
+    }
+    for (uint8_t n = 0; n < rx_len; n++) {
+      // open drain: colliding sensors AND their bits together
+      uint8_t value = sensor->readRegister(reg);
+      rx[n] = answered ? (rx[n] & value) : value;
+      reg += increment;
+    }
+    answered++;
+  }
+
+  if (!answered) {
+    sim_counters.nacks++;
+    for (uint8_t n = 0; n < rx_len; n++) {
+      rx[n] = 0xFF; // nothing pulls the lines low
+    }
+    return 2;
+  }
+  if (answered > 1) {
+    sim_counters.collisions++;
+  }
+  return 0;
+}
+
+/*!
+ *    @brief  Sets the clock; the simulated bus runs at `sim_bus_hz` instead
+ *    @param  frequency The clock in Hz
+ */
+void TwoWire::setClock(uint32_t frequency) { (void)frequency; }
+
+/*!
+ *    @brief  Starts buffering a write
+ *    @param  address The 7-bit device address
+ */
+void TwoWire::beginTransmission(uint8_t address) {
+  _address = address;
+  _tx_len = 0;
+  _pending = false;
+}
+
+/*!
+ *    @brief  Buffers a byte to write
+ *    @param  data The byte
+ *    @return 1, or 0 if the buffer is full
+ */
+size_t TwoWire::write(uint8_t data) {
+  if (_tx_len == HOST_WIRE_BUFFER_LENGTH) {
+    return 0;
+  }
+  _tx[_tx_len++] = data;
+  return 1;
+}
+
+/*!
+ *    @brief  Buffers bytes to write
+ *    @param  data The bytes
+ *    @param  quantity The number of bytes
+ *    @return The number of bytes buffered
+ */
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t written = 0;
+  while (written < quantity && write(data[written])) {
+    written++;
+  }
+  return written;
+}
+
+/*!
+ *    @brief  Sends the buffered write. Without a stop the write is held and
+ *            sent with the next `requestFrom()` as one transaction
+ *    @param  sendStop False to follow with a repeated start
+ *    @return 0 on success, or 2 if the address wasn't acknowledged
+ */
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+  if (!sendStop) {
+    _pending = true;
+    return 0;
+  }
+  _pending = false;
+  return sim_transfer(this, _address, _tx, _tx_len, NULL, 0);
+}
+
+/*!
+ *    @brief  Reads bytes from a device, after any write held by
+ *            `endTransmission(false)`
+ *    @param  address The 7-bit device address
+ *    @param  quantity The number of bytes to read
+ *    @param  sendStop Ignored; every read ends the transaction
+ *    @return The number of bytes read, 0 if the device didn't answer
+ */
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity,
+                             uint8_t sendStop) {
+  (void)sendStop;
+  if (quantity > HOST_WIRE_BUFFER_LENGTH) {
+    quantity = HOST_WIRE_BUFFER_LENGTH;
+  }
+  uint8_t tx_len = (_pending && _address == address) ? _tx_len : 0;
+  _pending = false;
+  _rx_index = 0;
+  _rx_len = 0;
+  if (sim_transfer(this, address, _tx, tx_len, _rx, quantity) != 0) {
+    return 0;
+  }
+  _rx_len = quantity;
+  return quantity;
+}
+
+/*!
+ *    @brief  Gets the number of read bytes not yet handed out
+ *    @return The number of bytes
+ */
+int TwoWire::available(void) { return _rx_len - _rx_index; }
+
+/*!
+ *    @brief  Hands out the next read byte
+ *    @return The byte, or -1 if there are none
+ */
+int TwoWire::read(void) {
+  if (_rx_index == _rx_len) {
+    return -1;
+  }
+  return _rx[_rx_index++];
+}
+
+TwoWire Wire;
+TwoWire Wire1;
@@ -0,0 +1,81 @@
+/*!
+ *  @file hts221_sim.h
+ *
+ * 	A simulated HTS221 register model and I2C bus for building and measuring
+ * 	the Adafruit HTS221 library on a host.
+ *
+ * 	Sensors are attached to a `TwoWire` bus, directly or behind a TCA9548A
+ * 	mux channel, and answer at 0x5F. Every transfer is counted and advances
+ * 	a simulated clock by the time it would take on the wire, which is also
+ * 	what `millis()` and `micros()` read.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HTS221_SIM_H
+#define _HTS221_SIM_H
+
+#include <Wire.h>
+
+#define SIM_HTS221_ADDRESS 0x5F ///< Fixed I2C address of the HTS221
+#define SIM_NO_MUX 0xFF         ///< Mux address for a directly attached sensor
+#define SIM_MAX_SENSORS 16      ///< Most sensors that can be attached
+#define SIM_MAX_MUXES 8         ///< Most muxes that can be attached
+#define SIM_BOOT_US 2000        ///< Time BOOT takes to clear
+#define SIM_ONE_SHOT_US 5000    ///< Time a one shot conversion takes
+
+/**
+ * @brief Bus traffic counted across every simulated bus
+ */
+typedef struct {
+  uint32_t transactions; ///< Transfers from a start to a stop
+  uint32_t bytes;        ///< Register address and data bytes moved
+  uint32_t nacks;        ///< Transfers no device acknowledged
+  uint32_t collisions;   ///< Transfers more than one sensor answered
+  uint32_t mux_writes;   ///< Writes to a mux's channel register
+  uint64_t bus_us;       ///< Simulated time spent on the bus
+} sim_counters_t;
+
+/*!
+ *    @brief  The register map and conversion timing of one HTS221
+ */
+class HTS221_Sim {
+public:
+  HTS221_Sim(void);
+
+  void powerOn(void);
+  void setOutputs(int16_t temperature, int16_t humidity);
+  uint8_t readRegister(uint8_t reg);
+  void writeRegister(uint8_t reg, uint8_t value);
+  void update(uint64_t now_us);
+
+  uint32_t conversions = 0; ///< Samples latched into the outputs
+  bool stuck_boot = false;  ///< BOOT never clears, as with a dead chip
+  uint8_t ignore_next = 0;  ///< Transfers to leave unacknowledged
+
+private:
+  void _convert(void);
+
+  uint8_t _regs[0x40];            ///< Registers 0x00-0x3F
+  int16_t _temperature;           ///< TEMP_OUT of the next conversion
+  int16_t _humidity;              ///< HUMIDITY_OUT of the next conversion
+  uint64_t _now_us = 0;           ///< Time of the last update
+  uint64_t _boot_done_us = 0;     ///< When BOOT clears, or 0
+  uint64_t _next_sample_us = 0;   ///< Next continuous sample, or 0
+  uint64_t _one_shot_done_us = 0; ///< When the one shot finishes, or 0
+};
+
+void sim_reset(void);
+bool sim_attach(HTS221_Sim *sensor, TwoWire *wire = &Wire,
+                uint8_t mux_address = SIM_NO_MUX, uint8_t mux_channel = 0);
+uint64_t sim_now(void);
+void sim_advance(uint64_t us);
+uint8_t sim_transfer(TwoWire *wire, uint8_t address, const uint8_t *tx,
+                     uint8_t tx_len, uint8_t *rx, uint8_t rx_len);
+
+extern sim_counters_t sim_counters; ///< Traffic since `sim_reset()`
+extern uint32_t sim_bus_hz;         ///< I2C clock; 100 kHz by default
+extern uint32_t sim_latency_us;     ///< Extra time added to every transfer
+extern bool sim_bus_fail;           ///< Nothing acknowledges while set
+
+#endif
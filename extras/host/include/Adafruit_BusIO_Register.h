@@ -0,0 +1,45 @@
+/*!
+ *  @file Adafruit_BusIO_Register.h
+ *
+ * 	Host stand-in for Adafruit BusIO's register helper, covering the buffer
+ * 	reads and writes the HTS221 library makes.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_ADAFRUIT_BUSIO_REGISTER_H
+#define _HOST_ADAFRUIT_BUSIO_REGISTER_H
+
+#include <Adafruit_I2CDevice.h>
+#include <Adafruit_SPIDevice.h>
+
+/** How the read/write bit is put into an SPI register address */
+typedef enum _Adafruit_BusIO_SPIRegType {
+  ADDRBIT8_HIGH_TOREAD = 0,
+  AD8_HIGH_TOREAD_AD7_HIGH_TOINC = 1,
+  ADDRBIT8_HIGH_TOWRITE = 2,
+  ADDRESSED_OPCODE_BIT0_LOWREAD_HIGHWRITE = 3,
+} Adafruit_BusIO_SPIRegType;
+
+/*!
+ *    @brief  A register on an I2C or SPI device
+ */
+class Adafruit_BusIO_Register {
+public:
+  Adafruit_BusIO_Register(Adafruit_I2CDevice *i2cdevice,
+                          Adafruit_SPIDevice *spidevice,
+                          Adafruit_BusIO_SPIRegType type, uint16_t reg_addr,
+                          uint8_t width = 1, uint8_t byteorder = LSBFIRST,
+                          uint8_t address_width = 1);
+
+  bool read(uint8_t *buffer, uint8_t len);
+  bool write(uint8_t *buffer, uint8_t len);
+
+private:
+  Adafruit_I2CDevice *_i2cdevice;        ///< The I2C device, if on I2C
+  Adafruit_SPIDevice *_spidevice;        ///< The SPI device, if on SPI
+  Adafruit_BusIO_SPIRegType _spiregtype; ///< SPI read/write bit style
+  uint16_t _address;                     ///< Register address
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*!
+ *  @file Adafruit_I2CDevice.h
+ *
+ * 	Host stand-in for Adafruit BusIO's I2C device, making the same Wire calls
+ * 	as the real one so the simulated bus sees the same transactions.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_ADAFRUIT_I2CDEVICE_H
+#define _HOST_ADAFRUIT_I2CDEVICE_H
+
+#include <Wire.h>
+
+/*!
+ *    @brief  One device on an I2C bus
+ */
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire);
+  uint8_t address(void);
+  bool begin(bool addr_detect = true);
+  void end(void);
+  bool detected(void);
+
+  bool read(uint8_t *buffer, size_t len, bool stop = true);
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false);
+  bool setSpeed(uint32_t desiredclk);
+
+  /*!
+   *    @brief  Gets the largest transfer the bus can make at once
+   *    @return The buffer size in bytes
+   */
+  size_t maxBufferSize() { return HOST_WIRE_BUFFER_LENGTH; }
+
+private:
+  uint8_t _addr;       ///< 7-bit address
+  TwoWire *_wire;      ///< The bus the device is on
+  bool _begun = false; ///< `begin()` has been called
+
+  bool _read(uint8_t *buffer, size_t len, bool stop);
+};
+
+#endif
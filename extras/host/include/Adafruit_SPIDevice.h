@@ -0,0 +1,44 @@
+/*!
+ *  @file Adafruit_SPIDevice.h
+ *
+ * 	Host stand-in for Adafruit BusIO's SPI device. Only I2C is simulated, so
+ * 	every transfer fails as if nothing were attached.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_ADAFRUIT_SPIDEVICE_H
+#define _HOST_ADAFRUIT_SPIDEVICE_H
+
+#include <SPI.h>
+
+/** Bit order of an SPI device */
+typedef enum _BitOrder {
+  SPI_BITORDER_MSBFIRST = MSBFIRST,
+  SPI_BITORDER_LSBFIRST = LSBFIRST,
+} BusIOBitOrder;
+
+/*!
+ *    @brief  One device on an SPI bus
+ */
+class Adafruit_SPIDevice {
+public:
+  Adafruit_SPIDevice(int8_t cspin, uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0, SPIClass *theSPI = &SPI);
+  Adafruit_SPIDevice(int8_t cspin, int8_t sck, int8_t miso, int8_t mosi,
+                     uint32_t freq = 1000000,
+                     BusIOBitOrder dataOrder = SPI_BITORDER_MSBFIRST,
+                     uint8_t dataMode = SPI_MODE0);
+
+  bool begin(void);
+  bool read(uint8_t *buffer, size_t len, uint8_t sendvalue = 0xFF);
+  bool write(const uint8_t *buffer, size_t len,
+             const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       uint8_t sendvalue = 0xFF);
+  bool write_and_read(uint8_t *buffer, size_t len);
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*!
+ *  @file Adafruit_Sensor.h
+ *
+ * 	Host stand-in for the Adafruit Unified Sensor types the HTS221 library
+ * 	uses.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_ADAFRUIT_SENSOR_H
+#define _HOST_ADAFRUIT_SENSOR_H
+
+#include "Arduino.h"
+
+#define SENSOR_TYPE_AMBIENT_TEMPERATURE 13 ///< Temperature in degrees C
+#define SENSOR_TYPE_RELATIVE_HUMIDITY 12   ///< Humidity in percent
+
+/** A reading from a Unified Sensor */
+typedef struct {
+  int32_t version;   ///< Must be sizeof(struct sensors_event_t)
+  int32_t sensor_id; ///< Unique sensor identifier
+  int32_t type;      ///< Sensor type
+  int32_t reserved0; ///< Reserved
+  int32_t timestamp; ///< Time in milliseconds
+  union {
+    float data[4];           ///< Raw data
+    float temperature;       ///< Temperature in degrees C
+    float relative_humidity; ///< Relative humidity in percent
+  };
+} sensors_event_t;
+
+/** A description of a Unified Sensor */
+typedef struct {
+  char name[12];     ///< Sensor name
+  int32_t version;   ///< Version of the hardware and driver
+  int32_t sensor_id; ///< Unique sensor identifier
+  int32_t type;      ///< Sensor type
+  float max_value;   ///< Maximum value
+  float min_value;   ///< Minimum value
+  float resolution;  ///< Smallest difference between two values
+  int32_t min_delay; ///< Minimum delay in microseconds between events
+} sensor_t;
+
+/*!
+ *    @brief  The Unified Sensor interface
+ */
+class Adafruit_Sensor {
+public:
+  virtual ~Adafruit_Sensor() {}
+  /*!
+   *    @brief  Gets the latest reading
+   *    @param  event Set to the reading
+   *    @return True if the reading succeeded
+   */
+  virtual bool getEvent(sensors_event_t *event) = 0;
+  /*!
+   *    @brief  Describes the sensor
+   *    @param  sensor Set to the description
+   */
+  virtual void getSensor(sensor_t *sensor) = 0;
+  void printSensorDetails(void) {}
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*!
+ *  @file Arduino.h
+ *
+ * 	Host stand-in for the parts of the Arduino core the HTS221 library uses.
+ * 	Time comes from the simulated clock in hts221_sim.h, so delays cost
+ * 	nothing and bus transfers take as long as they would on the wire.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean; ///< Arduino's name for bool
+typedef uint8_t byte; ///< Arduino's name for uint8_t
+
+#define HIGH 0x1         ///< Pin level high
+#define LOW 0x0          ///< Pin level low
+#define INPUT 0x0        ///< Pin mode input
+#define OUTPUT 0x1       ///< Pin mode output
+#define INPUT_PULLUP 0x2 ///< Pin mode input with pull-up
+#define RISING 3         ///< Interrupt on a rising edge
+#define FALLING 2        ///< Interrupt on a falling edge
+
+#define PROGMEM  ///< Flash data is plain data on the host
+#define F(s) (s) ///< Flash strings are plain strings on the host
+/** Reads a byte from flash */
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+/** Reads a 16-bit word from flash */
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+/** Reads a 32-bit word from flash */
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+
+#define noInterrupts() ///< Nothing interrupts the host build
+#define interrupts()   ///< Nothing interrupts the host build
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+#endif
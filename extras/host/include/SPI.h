@@ -0,0 +1,61 @@
+/*!
+ *  @file SPI.h
+ *
+ * 	Host stand-in for the Arduino SPI library. Only I2C is simulated, so
+ * 	transfers read back an idle bus.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_SPI_H
+#define _HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00 ///< CPOL 0, CPHA 0
+#define SPI_MODE1 0x04 ///< CPOL 0, CPHA 1
+#define SPI_MODE2 0x08 ///< CPOL 1, CPHA 0
+#define SPI_MODE3 0x0C ///< CPOL 1, CPHA 1
+#define LSBFIRST 0     ///< Least significant bit first
+#define MSBFIRST 1     ///< Most significant bit first
+
+/*!
+ *    @brief  SPI clock, bit order and mode for a transaction
+ */
+class SPISettings {
+public:
+  /*!
+   *    @brief  Creates the settings
+   *    @param  clock The clock in Hz
+   *    @param  bitOrder LSBFIRST or MSBFIRST
+   *    @param  dataMode One of the SPI_MODEn values
+   */
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
+    (void)clock;
+    (void)bitOrder;
+    (void)dataMode;
+  }
+};
+
+/*!
+ *    @brief  An SPI bus with nothing on it
+ */
+class SPIClass {
+public:
+  void begin(void) {}
+  void beginTransaction(SPISettings settings) { (void)settings; }
+  void endTransaction(void) {}
+  /*!
+   *    @brief  Exchanges one byte
+   *    @param  data The byte to send
+   *    @return 0xFF, an idle bus
+   */
+  uint8_t transfer(uint8_t data) {
+    (void)data;
+    return 0xFF;
+  }
+};
+
+extern SPIClass SPI; ///< The default SPI bus
+
+#endif
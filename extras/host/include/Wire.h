@@ -0,0 +1,49 @@
+/*!
+ *  @file Wire.h
+ *
+ * 	Host stand-in for the Arduino Wire library. Transfers go to the devices
+ * 	attached with `sim_attach()` in hts221_sim.h instead of real hardware.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#ifndef _HOST_WIRE_H
+#define _HOST_WIRE_H
+
+#include "Arduino.h"
+
+#define HOST_WIRE_BUFFER_LENGTH 32 ///< Transfer size limit, as on AVR
+
+/*!
+ *    @brief  An I2C bus. Like the AVR Wire library, writes are buffered
+ *            until `endTransmission()` and reads until `requestFrom()`
+ */
+class TwoWire {
+public:
+  void begin(void) {}
+  void setClock(uint32_t frequency);
+
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+  size_t write(const uint8_t *data, size_t quantity);
+  uint8_t endTransmission(uint8_t sendStop = true);
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity,
+                      uint8_t sendStop = true);
+  int available(void);
+  int read(void);
+
+private:
+  uint8_t _address = 0;                 ///< Address being written
+  uint8_t _tx[HOST_WIRE_BUFFER_LENGTH]; ///< Bytes to write
+  uint8_t _tx_len = 0;                  ///< Number of bytes to write
+  bool _pending = false;                ///< Write ended in a restart
+  uint8_t _rx[HOST_WIRE_BUFFER_LENGTH]; ///< Bytes read
+  uint8_t _rx_len = 0;                  ///< Number of bytes read
+  uint8_t _rx_index = 0;                ///< Next byte to hand out
+};
+
+extern TwoWire Wire;  ///< The first I2C bus
+extern TwoWire Wire1; ///< A second I2C bus
+
+#endif
@@ -0,0 +1,115 @@
+/*!
+ *  @file test_alloc.cpp
+ *
+ * 	Host test that begin and the read paths never touch the heap. malloc()
+ * 	and friends are replaced with counting versions that forward to glibc,
+ * 	which also catches `operator new`, since libstdc++ builds it on malloc().
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_HTS221.h>
+#include <stdio.h>
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+static bool counting = false;
+static uint32_t allocations = 0;
+
+void *malloc(size_t size) {
+  allocations += counting;
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+  allocations += counting;
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  allocations += counting;
+  return __libc_realloc(ptr, size);
+}
+}
+
+static int failures = 0;
+
+/** Runs a statement and fails if it allocated */
+#define CHECK_NO_ALLOC(statement)                                              \
+  do {                                                                         \
+    allocations = 0;                                                           \
+    counting = true;                                                           \
+    statement;                                                                 \
+    counting = false;                                                          \
+    if (allocations) {                                                         \
+      printf("%s:%d: %s allocated %u times\n", __FILE__, __LINE__, #statement, \
+             (unsigned)allocations);                                           \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+int main(void) {
+  // make sure the counting works at all
+  allocations = 0;
+  counting = true;
+  int *check = new int(1);
+  counting = false;
+  delete check;
+  if (allocations != 1) {
+    printf("test_alloc: allocations aren't being counted\n");
+    return 1;
+  }
+
+  HTS221_Sim sim;
+  sim_reset();
+  sim_attach(&sim);
+
+  Adafruit_HTS221 hts;
+  sensors_event_t temp, humidity;
+  int16_t centi_temp, centi_humidity;
+  hts221_raw_record_t records[4];
+  hts221_reading_t reading;
+
+  CHECK_NO_ALLOC(hts.begin_I2C());
+  CHECK_NO_ALLOC(hts.begin_I2C());
+  CHECK_NO_ALLOC(hts.begin_SPI(10));
+  CHECK_NO_ALLOC(hts.startBegin_I2C());
+  CHECK_NO_ALLOC(while (hts.pollBegin() == HTS221_BEGIN_BUSY) delay(1));
+
+  delay(100);
+  CHECK_NO_ALLOC(hts.getEvent(&humidity, &temp));
+  CHECK_NO_ALLOC(hts.getEvent(&humidity, &temp));
+  delay(100);
+  CHECK_NO_ALLOC(hts.getTemperatureSensor()->getEvent(&temp));
+  CHECK_NO_ALLOC(hts.getHumiditySensor()->getEvent(&humidity));
+  delay(100);
+  CHECK_NO_ALLOC(hts.readCenti(&centi_temp, &centi_humidity));
+  delay(100);
+  CHECK_NO_ALLOC(hts.readBatch(records, 4));
+  CHECK_NO_ALLOC(hts.convertBatch(records, 1, &centi_temp, &centi_humidity));
+  CHECK_NO_ALLOC(hts.checkWatch(&humidity, &temp));
+
+  hts.setDataRate(HTS221_RATE_ONE_SHOT);
+  CHECK_NO_ALLOC(hts.startOneShot());
+  CHECK_NO_ALLOC(while (!hts.pollOneShot()) delay(1));
+  CHECK_NO_ALLOC(hts.requestSample());
+  CHECK_NO_ALLOC(while (hts.pollSample(&reading) == HTS221_SAMPLE_BUSY)
+                     delay(1));
+
+  // the paths above really ran and produced a reading
+  if (reading.temperature != 2811 || reading.humidity != 5760) {
+    printf("test_alloc: no reading came through\n");
+    failures++;
+  }
+
+  if (failures) {
+    printf("test_alloc: %d failed\n", failures);
+    return 1;
+  }
+  printf("test_alloc: ok\n");
+  return 0;
+}
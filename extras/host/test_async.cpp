@@ -0,0 +1,150 @@
+/*!
+ *  @file test_async.cpp
+ *
+ * 	Host test of the split-phase read. With a slow bus, set by the extra
+ * 	latency every transfer takes, each `pollSample()` must still make at
+ * 	most one transaction, so the longest call stays near one transfer while
+ * 	a blocking one shot read takes the whole conversion. A one shot after
+ * 	continuous mode must wait for its own conversion, not finish on the
+ * 	data ready bits the last continuous sample left.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_HTS221.h>
+#include <stdio.h>
+
+#define LOOP_WORK_US 200 ///< Time the simulated control loop spends per pass
+
+static int failures = 0;
+
+/** Reports a failed check without stopping the test */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void testLatency(uint32_t latency_us) {
+  HTS221_Sim sim;
+  Adafruit_HTS221 hts;
+  sim_reset();
+  sim_attach(&sim);
+  CHECK(hts.begin_I2C());
+  hts.setDataRate(HTS221_RATE_ONE_SHOT);
+  sim_latency_us = latency_us;
+
+  // blocking: start a one shot and wait in one call for the result
+  uint64_t start_us = sim_now();
+  int16_t temperature, humidity;
+  CHECK(hts.startOneShot());
+  while (!hts.pollOneShot()) {
+  }
+  CHECK(hts.readCenti(&temperature, &humidity));
+  uint64_t blocking_us = sim_now() - start_us;
+
+  // split phase: the control loop keeps running between polls
+  uint64_t longest_us = 0;
+  uint32_t polls = 0, most_transactions = 0;
+  start_us = sim_now();
+  CHECK(hts.requestSample());
+  hts221_reading_t reading;
+  hts221_sample_status_t status = HTS221_SAMPLE_BUSY;
+  while (status == HTS221_SAMPLE_BUSY) {
+    delayMicroseconds(LOOP_WORK_US);
+    uint32_t transactions = sim_counters.transactions;
+    uint64_t call_start_us = sim_now();
+    status = hts.pollSample(&reading);
+    uint64_t call_us = sim_now() - call_start_us;
+    transactions = sim_counters.transactions - transactions;
+    if (call_us > longest_us) {
+      longest_us = call_us;
+    }
+    if (transactions > most_transactions) {
+      most_transactions = transactions;
+    }
+    polls++;
+  }
+  uint64_t total_us = sim_now() - start_us;
+
+  printf("%10lu %12llu %12llu %6lu %14llu\n", (unsigned long)latency_us,
+         (unsigned long long)blocking_us, (unsigned long long)longest_us,
+         (unsigned long)polls, (unsigned long long)total_us);
+
+  CHECK(status == HTS221_SAMPLE_READY);
+  CHECK(reading.temperature == temperature);
+  CHECK(reading.humidity == humidity);
+  CHECK(most_transactions <= 1);
+  // the blocking read sits through the conversion, while no poll takes
+  // longer than one transfer: a 6 byte burst is under 1 ms at 100 kHz
+  CHECK(blocking_us >= SIM_ONE_SHOT_US);
+  CHECK(longest_us <= latency_us + 1000);
+
+  // the age is worked out each time the reading is handed over
+  delay(10);
+  uint32_t age_us = 0;
+  CHECK(hts.pollSample(&reading) == HTS221_SAMPLE_READY);
+  CHECK(reading.age_us == (uint32_t)micros() - reading.timestamp_us);
+  CHECK(reading.age_us >= 10000);
+  CHECK(hts.readCenti(&temperature, &humidity, &age_us));
+  CHECK(age_us == reading.age_us);
+}
+
+static void testOneShotAfterContinuous(void) {
+  HTS221_Sim sim;
+  Adafruit_HTS221 hts;
+  sim_reset();
+  sim_attach(&sim);
+  CHECK(hts.begin_I2C());
+  hts.setDataRate(HTS221_RATE_12_5_HZ);
+  delay(200); // leaves a continuous sample unread
+  hts.setDataRate(HTS221_RATE_ONE_SHOT);
+
+  uint32_t conversions = sim.conversions;
+  CHECK(hts.startOneShot());
+  CHECK(!hts.pollOneShot());
+  while (!hts.pollOneShot()) {
+    delay(1);
+  }
+  CHECK(sim.conversions == conversions + 1);
+
+  // the split-phase read starts its one shot the same way
+  hts.setDataRate(HTS221_RATE_12_5_HZ);
+  delay(200);
+  hts.setDataRate(HTS221_RATE_ONE_SHOT);
+  conversions = sim.conversions;
+  hts221_reading_t reading;
+  CHECK(hts.requestSample());
+  CHECK(hts.pollSample(&reading) == HTS221_SAMPLE_BUSY);
+  while (hts.pollSample(&reading) == HTS221_SAMPLE_BUSY) {
+    delay(1);
+  }
+  CHECK(sim.conversions == conversions + 1);
+}
+
+// pass latencies in microseconds to try others than the defaults
+int main(int argc, char **argv) {
+  printf("%10s %12s %12s %6s %14s\n", "latency us", "blocking us",
+         "longest poll", "polls", "split total us");
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      testLatency(strtoul(argv[i], NULL, 10));
+    }
+  } else {
+    testLatency(0);
+    testLatency(100);
+    testLatency(500);
+    testLatency(1000);
+  }
+  testOneShotAfterContinuous();
+
+  if (failures) {
+    printf("test_async: %d failed\n", failures);
+    return 1;
+  }
+  printf("test_async: ok\n");
+  return 0;
+}
@@ -0,0 +1,131 @@
+/*!
+ *  @file test_begin.cpp
+ *
+ * 	Host tests of the blocking and non-blocking init: both give up on a
+ * 	BOOT bit that never clears, calibration is only handed out after a
+ * 	begin that loaded it, and a warm start refuses calibration saved from
+ * 	another part. A Unified Sensor event read before the first sample
+ * 	comes back cleared rather than untouched.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_HTS221.h>
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+/** Reports a failed check without stopping the test */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void testStuckBoot(void) {
+  HTS221_Sim sim;
+  Adafruit_HTS221 hts;
+  sim_reset();
+  sim_attach(&sim);
+  sim.stuck_boot = true;
+
+  uint64_t start_us = sim_now();
+  CHECK(!hts.begin_I2C());
+  CHECK(sim_now() - start_us < (HTS221_BOOT_TIMEOUT_MS + 10) * 1000ULL);
+
+  hts.startBegin_I2C();
+  hts221_begin_status_t status;
+  while ((status = hts.pollBegin()) == HTS221_BEGIN_BUSY) {
+    delay(1);
+  }
+  CHECK(status == HTS221_BEGIN_ERROR);
+
+  sim.stuck_boot = false;
+  sim.powerOn();
+  CHECK(hts.begin_I2C());
+}
+
+static void testCalibrationNeedsBegin(void) {
+  HTS221_Sim sim;
+  Adafruit_HTS221 hts;
+  hts221_calibration_t calibration;
+  sim_reset();
+  sim_attach(&sim);
+
+  CHECK(!hts.getCalibration(&calibration));
+  CHECK(hts.begin_I2C());
+  CHECK(hts.getCalibration(&calibration));
+
+  // a begin that fails part way leaves nothing to save
+  sim.stuck_boot = true;
+  sim.powerOn();
+  CHECK(!hts.begin_I2C());
+  CHECK(!hts.getCalibration(&calibration));
+  sim.stuck_boot = false;
+  sim.powerOn();
+}
+
+static void testWarmStartChecksPart(void) {
+  HTS221_Sim sim;
+  Adafruit_HTS221 hts;
+  hts221_calibration_t saved, other, loaded;
+  sim_reset();
+  sim_attach(&sim);
+  CHECK(hts.begin_I2C());
+  CHECK(hts.getCalibration(&saved));
+
+  // the saved calibration of this part skips the boot
+  uint64_t start_us = sim_now();
+  CHECK(hts.begin_I2C(&saved));
+  CHECK(sim_now() - start_us < SIM_BOOT_US);
+
+  // an intact blob from another part is refused, and this part booted and
+  // read as usual
+  other = saved;
+  other.t0_out += 100;
+  other.crc = hts221_calibrationCRC(&other);
+  start_us = sim_now();
+  CHECK(hts.begin_I2C(&other));
+  CHECK(sim_now() - start_us >= SIM_BOOT_US);
+  CHECK(hts.getCalibration(&loaded));
+  CHECK(loaded.t0_out == saved.t0_out);
+}
+
+static void testEventBeforeFirstSample(void) {
+  HTS221_Sim sim;
+  Adafruit_HTS221 hts;
+  sim_reset();
+  sim_attach(&sim);
+  CHECK(hts.begin_I2C());
+
+  sensors_event_t event;
+  memset(&event, 0xA5, sizeof(event));
+  CHECK(!hts.getTemperatureSensor()->getEvent(&event));
+  CHECK(event.version == sizeof(sensors_event_t));
+  CHECK(event.type == SENSOR_TYPE_AMBIENT_TEMPERATURE);
+  CHECK(event.timestamp == (int32_t)millis());
+  CHECK(event.temperature == 0);
+
+  memset(&event, 0xA5, sizeof(event));
+  CHECK(!hts.getHumiditySensor()->getEvent(&event));
+  CHECK(event.version == sizeof(sensors_event_t));
+  CHECK(event.relative_humidity == 0);
+}
+
+int main(void) {
+  testStuckBoot();
+  testCalibrationNeedsBegin();
+  testWarmStartChecksPart();
+  testEventBeforeFirstSample();
+
+  if (failures) {
+    printf("test_begin: %d failed\n", failures);
+    return 1;
+  }
+  printf("test_begin: ok\n");
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*!
+ *  @file test_capture.cpp
+ *
+ * 	Host tests of DRDY capture alongside the other read paths, including
+ * 	the rate governor. Whichever call reads a new sample, every conversion
+ * 	the sensor makes must end up either in the capture queue or counted as
+ * 	dropped.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_HTS221.h>
+#include <Adafruit_HTS221_Governor.h>
+#include <stdio.h>
+
+#define CAPTURE_SIZE 4 ///< Capture queue entries; one is kept free
+#define LOOPS 3000     ///< Passes of the simulated main loop
+
+static int failures = 0;
+static uint32_t seed = 1;
+
+/** Reports a failed check without stopping the test */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// a repeatable pseudo random number below limit, for loop jitter
+static uint32_t jitter(uint32_t limit) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) % limit;
+}
+
+/*!
+ *    @brief  Plays the DRDY interrupt: flags an edge if the sensor has
+ *            converted since the last call
+ *    @param  sim The simulated sensor
+ *    @param  hts The driver to flag
+ *    @param  conversions The sensor's conversions at the last call; updated
+ */
+static void drdy(HTS221_Sim *sim, Adafruit_HTS221 *hts,
+                 uint32_t *conversions) {
+  sim->update(sim_now());
+  if (sim->conversions != *conversions) {
+    *conversions = sim->conversions;
+    hts->dataReady();
+  }
+}
+
+/*!
+ *    @brief  Runs a main loop that mixes other reads with `service()` and
+ *            checks that no conversion went missing
+ *    @param  name The label for failures
+ *    @param  sim The simulated sensor
+ *    @param  hts The driver, begun and with its last sample read
+ *    @param  read The other read to make, given the loop pass
+ */
+static void runLoop(const char *name, HTS221_Sim *sim, Adafruit_HTS221 *hts,
+                    void (*read)(uint16_t pass)) {
+  hts221_raw_sample_t storage[CAPTURE_SIZE];
+  Adafruit_HTS221_SampleBuffer buffer(storage, CAPTURE_SIZE);
+  hts221_raw_record_t records[CAPTURE_SIZE];
+  sim->update(sim_now());
+  uint32_t conversions = sim->conversions;
+  uint32_t start = conversions;
+  uint32_t captured = 0;
+  hts->startCapture(&buffer);
+
+  for (uint16_t pass = 0; pass < LOOPS; pass++) {
+    delay(1 + jitter(9));
+    drdy(sim, hts, &conversions);
+    // the other read sometimes gets to the sample before service() does
+    if (jitter(2)) {
+      read(pass);
+    }
+    drdy(sim, hts, &conversions);
+    hts->service();
+    if (!jitter(40)) {
+      uint32_t ages_us[CAPTURE_SIZE];
+      uint16_t count = hts->readBatch(records, CAPTURE_SIZE, NULL, ages_us);
+      // queued oldest first, each aged from its own conversion
+      for (uint16_t i = 1; i < count; i++) {
+        CHECK(ages_us[i - 1] > ages_us[i]);
+      }
+      captured += count;
+    }
+  }
+  drdy(sim, hts, &conversions);
+  hts->service();
+  captured += hts->readBatch(records, CAPTURE_SIZE);
+  hts->stopCapture();
+
+  uint32_t made = sim->conversions - start;
+  uint32_t dropped = hts->getDroppedSamples();
+  printf("%-22s %6lu conversions %6lu captured %6lu dropped\n", name,
+         (unsigned long)made, (unsigned long)captured, (unsigned long)dropped);
+  if (captured + dropped != made) {
+    printf("%s: %lu samples lost\n", name,
+           (unsigned long)(made - captured - dropped));
+    failures++;
+  }
+  CHECK(captured > 0);
+}
+
+static HTS221_Sim sim;
+static Adafruit_HTS221 hts;
+
+static void getEvent(uint16_t pass) {
+  (void)pass;
+  sensors_event_t temp, humidity;
+  hts.getEvent(&humidity, &temp);
+}
+
+static void readCenti(uint16_t pass) {
+  (void)pass;
+  int16_t temperature, humidity;
+  hts.readCenti(&temperature, &humidity);
+}
+
+static void testMixedReads(void) {
+  sim_reset();
+  sim.powerOn();
+  sim_attach(&sim);
+  CHECK(hts.begin_I2C());
+  delay(100);
+  readCenti(0);
+
+  runLoop("getEvent() + service()", &sim, &hts, getEvent);
+  runLoop("readCenti() + service()", &sim, &hts, readCenti);
+}
+
+static Adafruit_HTS221_Governor governor(&hts);
+
+static void governorUpdate(uint16_t pass) {
+  // changing fast for the first half so the rate goes up, then steady so
+  // it comes back down to one shots
+  int16_t step = (pass < LOOPS / 2) ? (int16_t)(pass % 64) * 8 : 0;
+  sim.setOutputs(300 + step, 6000 + step);
+  int16_t temperature, humidity;
+  governor.update(&temperature, &humidity);
+}
+
+static void testGovernor(void) {
+  sim_reset();
+  sim.powerOn();
+  sim_attach(&sim);
+  CHECK(hts.begin_I2C());
+  delay(100);
+  readCenti(0);
+  governor.begin(HTS221_RATE_1_HZ);
+
+  runLoop("governor + service()", &sim, &hts, governorUpdate);
+  CHECK(governor.getTransitions() >= 2);
+}
+
+int main(void) {
+  testMixedReads();
+  testGovernor();
+
+  if (failures) {
+    printf("test_capture: %d failed\n", failures);
+    return 1;
+  }
+  printf("test_capture: ok\n");
+  return 0;
+}
@@ -0,0 +1,44 @@
+/*!
+ *  @file test_filter.cpp
+ *
+ * 	Host test that the filter's moving average settles exactly on a steady
+ * 	input, rising or falling, at every smoothing shift.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include <Adafruit_HTS221_Filter.h>
+#include <stdio.h>
+
+int main(void) {
+  static const int16_t steps[][2] = {
+      {0, 100}, {100, 0}, {-50, 50}, {50, -50}, {2000, -2000}, {0, 1}};
+  int failures = 0;
+
+  for (uint8_t shift = 1; shift <= HTS221_FILTER_MAX_SHIFT; shift++) {
+    for (uint8_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+      Adafruit_HTS221_Filter filter(1, shift);
+      hts221_raw_sample_t sample = {0, steps[i][0], steps[i][0]};
+      filter.process(&sample);
+      // far more than the time constant of the heaviest smoothing
+      for (uint16_t n = 0; n < 4000; n++) {
+        sample.temperature = steps[i][1];
+        sample.humidity = steps[i][1];
+        filter.process(&sample);
+      }
+      if (sample.temperature != steps[i][1] ||
+          sample.humidity != steps[i][1]) {
+        printf("shift %u: %d to %d settled at %d\n", shift, steps[i][0],
+               steps[i][1], sample.temperature);
+        failures++;
+      }
+    }
+  }
+
+  if (failures) {
+    printf("test_filter: %d failed\n", failures);
+    return 1;
+  }
+  printf("test_filter: ok\n");
+  return 0;
+}
@@ -0,0 +1,140 @@
+/*!
+ *  @file test_group.cpp
+ *
+ * 	Host tests for Adafruit_HTS221_Group: colliding sensors, including a
+ * 	direct sensor on a bus with muxed ones, and sensors past the storage
+ * 	given to the group are refused, begin() turns every
+ * 	mux off first, and a sensor whose one shot couldn't be started is
+ * 	reported invalid instead of repeating its last sample.
+ *
+ * 	BSD (see license.txt)
+ */
+
+#include "hts221_sim.h"
+#include <Adafruit_HTS221_Group.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+/** Reports a failed check without stopping the test */
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void testAddRefusesCollisions(void) {
+  Adafruit_HTS221 a, b, c, d, e;
+  hts221_group_member_t members[4];
+  hts221_group_reading_t readings[4];
+  Adafruit_HTS221_Group group(members, readings, 4);
+
+  CHECK(group.add(&a, &Wire1));
+  CHECK(!group.add(&b, &Wire1)); // both at 0x5F on Wire1
+  CHECK(group.add(&c, &Wire, 0x70, 0));
+  CHECK(!group.add(&d, &Wire, 0x70, 0));
+  CHECK(group.add(&d, &Wire, 0x70, 1));
+  CHECK(group.add(&e, &Wire, 0x71, 0));
+  CHECK(group.count() == 4);
+  CHECK(!group.add(&b, &Wire, 0x71, 1)); // no room left in the storage
+}
+
+static void testAddRefusesDirectBesideMux(void) {
+  Adafruit_HTS221 a, b;
+  hts221_group_member_t members[2][2];
+  hts221_group_reading_t readings[2][2];
+  Adafruit_HTS221_Group direct_first(members[0], readings[0], 2);
+  Adafruit_HTS221_Group muxed_first(members[1], readings[1], 2);
+
+  // the direct sensor would answer along with whatever channel is on
+  CHECK(direct_first.add(&a, &Wire));
+  CHECK(!direct_first.add(&b, &Wire, 0x70, 2));
+  CHECK(muxed_first.add(&a, &Wire, 0x70, 2));
+  CHECK(!muxed_first.add(&b, &Wire));
+  CHECK(muxed_first.add(&b, &Wire1));
+}
+
+static void testBeginTurnsMuxesOff(void) {
+  HTS221_Sim sims[4];
+  Adafruit_HTS221 sensors[4];
+  hts221_group_member_t members[4];
+  hts221_group_reading_t readings[4];
+  Adafruit_HTS221_Group group(members, readings, 4);
+
+  sim_reset();
+  for (uint8_t i = 0; i < 4; i++) {
+    uint8_t mux = (i < 2) ? 0x70 : 0x71;
+    sim_attach(&sims[i], &Wire, mux, i % 2);
+    CHECK(group.add(&sensors[i], &Wire, mux, i % 2));
+  }
+  // channels left on from before a reset: all four sensors answer at once
+  uint8_t all = 0xFF;
+  sim_transfer(&Wire, 0x70, &all, 1, NULL, 0);
+  sim_transfer(&Wire, 0x71, &all, 1, NULL, 0);
+  sim_counters.collisions = 0;
+
+  CHECK(group.begin());
+  CHECK(sim_counters.collisions == 0);
+
+  // continuous samples from begin are left waiting; only the one shots
+  // convert the new outputs
+  delay(200);
+  for (uint8_t i = 0; i < 4; i++) {
+    sims[i].update(sim_now());
+    sims[i].setOutputs(400, 7000);
+  }
+  hts221_group_snapshot_t snapshot;
+  CHECK(group.read(&snapshot));
+  CHECK(sim_counters.collisions == 0);
+  for (uint8_t i = 0; i < 4; i++) {
+    CHECK(snapshot.readings[i].valid);
+    // the first cycle waits for its own one shot on every sensor
+    CHECK(snapshot.readings[i].temperature != 2811);
+    CHECK(snapshot.readings[i].humidity != 5760);
+  }
+}
+
+static void testUntriggeredSensorIsInvalid(void) {
+  HTS221_Sim sims[3];
+  Adafruit_HTS221 sensors[3];
+  hts221_group_member_t members[3];
+  hts221_group_reading_t readings[3];
+  Adafruit_HTS221_Group group(members, readings, 3);
+
+  sim_reset();
+  for (uint8_t i = 0; i < 3; i++) {
+    sim_attach(&sims[i], &Wire, 0x70, i);
+    group.add(&sensors[i], &Wire, 0x70, i);
+  }
+  CHECK(group.begin());
+
+  hts221_group_snapshot_t snapshot;
+  CHECK(group.read(&snapshot));
+
+  // the second sensor misses the start of its next conversion
+  sims[1].ignore_next = 1;
+  uint32_t conversions = sims[1].conversions;
+  CHECK(!group.read(&snapshot));
+  CHECK(snapshot.readings[0].valid);
+  CHECK(!snapshot.readings[1].valid);
+  CHECK(snapshot.readings[2].valid);
+  CHECK(sims[1].conversions == conversions);
+
+  CHECK(group.read(&snapshot));
+  CHECK(snapshot.readings[1].valid);
+}
+
+int main(void) {
+  testAddRefusesCollisions();
+  testAddRefusesDirectBesideMux();
+  testBeginTurnsMuxesOff();
+  testUntriggeredSensorIsInvalid();
+  if (failures) {
+    printf("test_group: %d failed\n", failures);
+    return 1;
+  }
+  printf("test_group: ok\n");
+  return 0;
+}